@@ -0,0 +1,199 @@
+﻿#ifndef BITSLICEDKERNEL_H
+#define BITSLICEDKERNEL_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "StrategyFSM.h"
+#include "PayoffMatrix.h"
+#include "Random.h"
+#include "RandomEngine.h"
+#include "OutcomeCounts.h"
+
+/**
+ * @brief Bit-sliced engine that plays many noisy repeats of one FSM pairing in lockstep
+ * @tparam ScoreType The type used for scores
+ * @tparam Words Number of 64-bit words per bit plane; one repeat per bit lane (64 * Words lanes)
+ *
+ * Each player's FSM state is stored as bit planes (plane k holds bit k of the state for
+ * every lane), so a round advances all lanes with AND/OR/XOR on whole words. Noise masks
+ * come from geometric gap sampling, so the RNG cost follows the number of flips.
+ * Outcomes are tallied in bit-sliced (vertical) counters and only turned into scores at
+ * the end. The inner loops run over Words and are left to the compiler to vectorize.
+ */
+template<typename ScoreType = double, int Words = 4>
+class BitSlicedKernel {
+public:
+    static constexpr int LANES = 64 * Words;
+
+private:
+    using Word = std::uint64_t;
+    static constexpr int MAX_PLANES = 4;      // up to 16 FSM states
+    static constexpr int COUNTER_PLANES = 32; // rounds fit in an int
+
+    struct SlicedFSM {
+        int num_states = 0;
+        int planes = 0;
+        std::uint8_t initial = 0;
+        std::array<bool, StrategyFSM::MAX_STATES> defects{};
+        // For state s and plane k: set of outcome codes (bit c) whose target has bit k set
+        std::array<std::array<std::uint8_t, MAX_PLANES>, StrategyFSM::MAX_STATES> sets{};
+    };
+
+    SlicedFSM fsm1_, fsm2_;
+    PayoffMatrix<ScoreType> payoffs_;
+
+    static SlicedFSM slice(const StrategyFSM& fsm) {
+        SlicedFSM sliced;
+        sliced.num_states = fsm.num_states;
+        sliced.initial = fsm.initial_state;
+        while ((1 << sliced.planes) < fsm.num_states) ++sliced.planes;
+        for (int s = 0; s < fsm.num_states; ++s) {
+            sliced.defects[s] = fsm.output[s] == Move::Defect;
+            for (int k = 0; k < sliced.planes; ++k) {
+                std::uint8_t set = 0;
+                for (int code = 0; code < 4; ++code) {
+                    if ((fsm.next[s][code] >> k) & 1u) set |= static_cast<std::uint8_t>(1u << code);
+                }
+                sliced.sets[s][k] = set;
+            }
+        }
+        return sliced;
+    }
+
+    // Lane masks of every state, from the state planes of one word
+    static void stateMasks(const SlicedFSM& fsm, const Word* planes, Word* masks) {
+        for (int s = 0; s < fsm.num_states; ++s) {
+            Word m = ~Word(0);
+            for (int k = 0; k < fsm.planes; ++k) {
+                m &= ((s >> k) & 1) ? planes[k] : ~planes[k];
+            }
+            masks[s] = m;
+        }
+    }
+
+    static Word defectMask(const SlicedFSM& fsm, const Word* masks) {
+        Word out = 0;
+        for (int s = 0; s < fsm.num_states; ++s) {
+            if (fsm.defects[s]) out |= masks[s];
+        }
+        return out;
+    }
+
+    // Next state planes given my and the opponent's actual moves (1 = defect)
+    static void advance(const SlicedFSM& fsm, const Word* masks, Word mine, Word theirs, Word* planes) {
+        // unions[set] = lanes whose outcome code is in `set`
+        Word codes[4] = { ~mine & ~theirs, mine & ~theirs, ~mine & theirs, mine & theirs };
+        Word unions[16];
+        unions[0] = 0;
+        for (int set = 1; set < 16; ++set) {
+            int low = set & -set;
+            int code = low == 1 ? 0 : low == 2 ? 1 : low == 4 ? 2 : 3;
+            unions[set] = unions[set & (set - 1)] | codes[code];
+        }
+        for (int k = 0; k < fsm.planes; ++k) {
+            Word plane = 0;
+            for (int s = 0; s < fsm.num_states; ++s) {
+                plane |= masks[s] & unions[fsm.sets[s][k]];
+            }
+            planes[k] = plane;
+        }
+    }
+
+    // Add one to every lane set in `mask` (ripple carry through the counter planes)
+    static void increment(Word (*counter)[Words], int w, Word mask) {
+        for (int k = 0; mask != 0 && k < COUNTER_PLANES; ++k) {
+            Word carry = counter[k][w] & mask;
+            counter[k][w] ^= mask;
+            mask = carry;
+        }
+    }
+
+    static long long laneCount(const Word (*counter)[Words], int lane) {
+        long long count = 0;
+        for (int k = 0; k < COUNTER_PLANES; ++k) {
+            count |= static_cast<long long>((counter[k][lane / 64] >> (lane % 64)) & 1u) << k;
+        }
+        return count;
+    }
+
+public:
+    BitSlicedKernel(const StrategyFSM& fsm1, const StrategyFSM& fsm2, const PayoffMatrix<ScoreType>& payoffs)
+        : fsm1_(slice(fsm1)), fsm2_(slice(fsm2)), payoffs_(payoffs) {
+    }
+
+    // Play `lanes` (at most LANES) independent repeats, each player's move flipped with
+    // probability noise1 / noise2, and append the outcome counts of each repeat to `out`
+    void count(int rounds, double noise1, double noise2, std::uint64_t seed, int lanes,
+               std::vector<OutcomeCounts>& out, RngKind rng = RngKind::MT19937) const {
+        RandomEngine engine(seed, rng);
+        GeometricFlipSampler flips1(noise1, engine);
+        GeometricFlipSampler flips2(noise2, engine);
+
+        Word planes1[MAX_PLANES][Words];
+        Word planes2[MAX_PLANES][Words];
+        for (int k = 0; k < MAX_PLANES; ++k) {
+            for (int w = 0; w < Words; ++w) {
+                planes1[k][w] = ((fsm1_.initial >> k) & 1) ? ~Word(0) : 0;
+                planes2[k][w] = ((fsm2_.initial >> k) & 1) ? ~Word(0) : 0;
+            }
+        }
+
+        // Outcome tallies from player 1's view: CC, DC, CD (DD is the remainder)
+        Word counters[3][COUNTER_PLANES][Words] = {};
+        Word flip1[Words], flip2[Words];
+
+        for (int r = 0; r < rounds; ++r) {
+            flips1.fill(flip1, Words, engine);
+            flips2.fill(flip2, Words, engine);
+
+            for (int w = 0; w < Words; ++w) {
+                Word p1[MAX_PLANES], p2[MAX_PLANES];
+                for (int k = 0; k < MAX_PLANES; ++k) {
+                    p1[k] = planes1[k][w];
+                    p2[k] = planes2[k][w];
+                }
+                Word masks1[StrategyFSM::MAX_STATES], masks2[StrategyFSM::MAX_STATES];
+                stateMasks(fsm1_, p1, masks1);
+                stateMasks(fsm2_, p2, masks2);
+
+                Word d1 = defectMask(fsm1_, masks1) ^ flip1[w];
+                Word d2 = defectMask(fsm2_, masks2) ^ flip2[w];
+
+                advance(fsm1_, masks1, d1, d2, p1);
+                advance(fsm2_, masks2, d2, d1, p2);
+                for (int k = 0; k < MAX_PLANES; ++k) {
+                    planes1[k][w] = p1[k];
+                    planes2[k][w] = p2[k];
+                }
+
+                increment(counters[0], w, ~d1 & ~d2);
+                increment(counters[1], w, d1 & ~d2);
+                increment(counters[2], w, ~d1 & d2);
+            }
+        }
+
+        for (int lane = 0; lane < lanes && lane < LANES; ++lane) {
+            OutcomeCounts counts;
+            counts.rounds[0] = static_cast<double>(laneCount(counters[0], lane));
+            counts.rounds[1] = static_cast<double>(laneCount(counters[1], lane));
+            counts.rounds[2] = static_cast<double>(laneCount(counters[2], lane));
+            counts.rounds[3] = rounds - counts.rounds[0] - counts.rounds[1] - counts.rounds[2];
+            out.push_back(counts);
+        }
+    }
+
+    // Same as count(), scored with the kernel's payoff matrix
+    void play(int rounds, double noise1, double noise2, std::uint64_t seed, int lanes,
+              std::vector<std::pair<ScoreType, ScoreType>>& out, RngKind rng = RngKind::MT19937) const {
+        std::vector<OutcomeCounts> counts;
+        count(rounds, noise1, noise2, seed, lanes, counts, rng);
+        for (const OutcomeCounts& c : counts) {
+            out.push_back(c.score(payoffs_));
+        }
+    }
+};
+
+#endif // BITSLICEDKERNEL_H
@@ -9,6 +9,8 @@ struct Config {
     // Tournament parameters
     int rounds = 50;
     int repeats = 5;
+    double ci_target = 0.0;     // Adaptive repeats: add games until each pairing's 95% CI half-width is this small (0 = off)
+    int max_repeats = 10000;    // Adaptive repeats: most games per pairing
     double epsilon = 0;
     int seed = 42;
     std::vector<double> payoffs = { 5.0, 3.0, 1.0, 0.0 }; // T, R, P, S
@@ -23,6 +25,9 @@ struct Config {
     std::string format = "console";  // Output format: console (default), csv, json, markdown
     std::string save_file;           // Path to save configuration as JSON
     std::string load_file;           // Path to load configuration from JSON
+    std::string match_matrix;        // Stream the pairwise score matrix to this CSV file (not saved)
+    std::string cache;               // Memory-mapped file of per-pairing results reused across runs (not saved)
+    std::string samples;             // Keep every game score of the tournament and write them to this CSV file (not saved)
     
     // Q2: Noise sweep parameters
     bool noise_sweep = false;           // Whether to enable noise sweep mode
@@ -36,11 +41,58 @@ struct Config {
 	// Q4: Evolution simulation parameters
     bool evolve = false;
     int generations = 50;
+    int payoff_refresh = 0;            // Re-estimate the pairwise payoff matrix every N generations (0 = once)
+    std::string replicator = "discrete"; // Replicator dynamics: discrete map or rk45 (continuous time)
+    double convergence_tol = 1e-10;    // Stop once the shares repeat within this tolerance (0 = run all generations)
+    
+    // Finite population: fixation of a single mutant under a Moran or Wright-Fisher process
+    std::string finite;                // moran or wright-fisher (empty = off)
+    int population = 1000;             // Number of agents
+    int trajectories = 200;            // Independent runs per mutant/resident pair
+    double selection = 0.1;            // Intensity w: fitness = exp(w * average payoff per round)
+    int fixation_generations = 100000; // Give up on a run after this many generations
+    
+    // Spatial lattice: strategies on a torus that imitate their best-scoring neighbor
+    int lattice = 0;                   // Side of the square torus (0 = off, up to 4096)
+    std::string neighborhood = "moore"; // moore (8 neighbors) or von-neumann (4)
+    int snapshot_every = 0;            // Write a binary grid snapshot every N generations (0 = never)
+    
+    // Graph evolution: strategies on the nodes of an interaction network
+    std::string graph;                 // small-world, scale-free or the path of an edge-list file (empty = off)
+    int graph_nodes = 10000;           // Nodes of generated graphs
+    int graph_degree = 4;              // Mean degree of generated graphs (even)
+    double rewire = 0.1;               // Small-world rewiring probability
+    std::string graph_update = "sync"; // sync (best neighbor) or async (Fermi imitation, uses selection)
+    
+    // Island model: sub-populations evolving in parallel with periodic migration around a ring
+    int islands = 0;                   // Number of islands (0 = off); replicator dynamics, or finite if set
+    int migration_every = 10;          // Generations between migrations
+    double migration_rate = 0.1;       // Share of each island that moves to the next island
+    
+    // Genetic search: evolve memory-n lookup tables against the strategy field
+    bool optimize = false;
+    int optimize_depth = 3;            // Memory depth n of the evolved tables (4^n + n bits per genome)
+    int ga_population = 40;            // Genomes per generation; the best quarter survives unchanged
+    double mutation_rate = 0.01;       // Probability of flipping each bit of a child
     
     // Q5: SCB (Strategic Complexity Budget) parameters
     bool enable_scb = false;           // Whether to enable Strategic Complexity Budget
     double scb_cost_factor = 0.1;      // Cost coefficient per complexity unit per round
     bool scb_compare = false;          // Whether to run SCB comparison mode (with/without SCB)
+
+    // Performance: engine settings are saved; benchmark and threads only affect this run
+    bool benchmark = false;            // Benchmark match engines instead of running an experiment (not saved)
+    bool self_test = false;            // Run the built-in regression checks and exit (not saved)
+    bool exact = false;                // Exact Markov-chain expectations for memory-one pairs
+    int threads = 1;                   // Tournament worker threads, 0 = all cores (results do not depend on it; not saved)
+    std::string rng = "mt19937";       // RNG engine: mt19937, xoshiro256pp, pcg32 or philox
+
+    // Payoff grid: play the tournament once, then re-score it under every T/R/P/S combination
+    bool payoff_grid = false;
+    std::vector<double> grid_T = { 4.0, 5.0, 6.0 };
+    std::vector<double> grid_R = { 2.5, 3.0, 3.5 };
+    std::vector<double> grid_P = { 0.5, 1.0, 1.5 };
+    std::vector<double> grid_S = { 0.0 };
 };
 
 #endif // CONFIG_H
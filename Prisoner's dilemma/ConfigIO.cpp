@@ -1,7 +1,9 @@
 ﻿#include "ConfigIO.h"
+#include "Strategies.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <initializer_list>
 
 std::string ConfigIO::escapeJson(const std::string& str) {
     std::string result;
@@ -24,6 +26,8 @@ void ConfigIO::saveConfig(const Config& config, const std::string& filename) {
     file << "{\n";
     file << "  \"rounds\": " << config.rounds << ",\n";
     file << "  \"repeats\": " << config.repeats << ",\n";
+    file << "  \"ci_target\": " << config.ci_target << ",\n";
+    file << "  \"max_repeats\": " << config.max_repeats << ",\n";
     file << "  \"epsilon\": " << config.epsilon << ",\n";
     file << "  \"seed\": " << config.seed << ",\n";
     
@@ -64,11 +68,75 @@ void ConfigIO::saveConfig(const Config& config, const std::string& filename) {
     // Q4: Evolution parameters
     file << "  \"evolve\": " << (config.evolve ? "true" : "false") << ",\n";
     file << "  \"generations\": " << config.generations << ",\n";
+    file << "  \"payoff_refresh\": " << config.payoff_refresh << ",\n";
+    file << "  \"replicator\": \"" << escapeJson(config.replicator) << "\",\n";
+    file << "  \"convergence_tol\": " << config.convergence_tol << ",\n";
+
+    // Finite population parameters
+    file << "  \"finite\": \"" << escapeJson(config.finite) << "\",\n";
+    file << "  \"population\": " << config.population << ",\n";
+    file << "  \"trajectories\": " << config.trajectories << ",\n";
+    file << "  \"selection\": " << config.selection << ",\n";
+    file << "  \"fixation_generations\": " << config.fixation_generations << ",\n";
+
+    // Spatial lattice parameters
+    file << "  \"lattice\": " << config.lattice << ",\n";
+    file << "  \"neighborhood\": \"" << escapeJson(config.neighborhood) << "\",\n";
+    file << "  \"snapshot_every\": " << config.snapshot_every << ",\n";
+
+    // Graph evolution parameters
+    file << "  \"graph\": \"" << escapeJson(config.graph) << "\",\n";
+    file << "  \"graph_nodes\": " << config.graph_nodes << ",\n";
+    file << "  \"graph_degree\": " << config.graph_degree << ",\n";
+    file << "  \"rewire\": " << config.rewire << ",\n";
+    file << "  \"graph_update\": \"" << escapeJson(config.graph_update) << "\",\n";
+
+    // Island model parameters
+    file << "  \"islands\": " << config.islands << ",\n";
+    file << "  \"migration_every\": " << config.migration_every << ",\n";
+    file << "  \"migration_rate\": " << config.migration_rate << ",\n";
+
+    // Genetic search parameters
+    file << "  \"optimize\": " << (config.optimize ? "true" : "false") << ",\n";
+    file << "  \"optimize_depth\": " << config.optimize_depth << ",\n";
+    file << "  \"ga_population\": " << config.ga_population << ",\n";
+    file << "  \"mutation_rate\": " << config.mutation_rate << ",\n";
     
     // Q5: SCB parameters
     file << "  \"enable_scb\": " << (config.enable_scb ? "true" : "false") << ",\n";
     file << "  \"scb_cost_factor\": " << config.scb_cost_factor << ",\n";
-    file << "  \"scb_compare\": " << (config.scb_compare ? "true" : "false") << "\n";
+    file << "  \"scb_compare\": " << (config.scb_compare ? "true" : "false") << ",\n";
+
+    // Performance parameters
+    file << "  \"exact\": " << (config.exact ? "true" : "false") << ",\n";
+    file << "  \"rng\": \"" << escapeJson(config.rng) << "\",\n";
+
+    // Payoff grid parameters
+    file << "  \"payoff_grid\": " << (config.payoff_grid ? "true" : "false") << ",\n";
+    file << "  \"grid_T\": [";
+    for (size_t i = 0; i < config.grid_T.size(); ++i) {
+        file << config.grid_T[i];
+        if (i < config.grid_T.size() - 1) file << ", ";
+    }
+    file << "],\n";
+    file << "  \"grid_R\": [";
+    for (size_t i = 0; i < config.grid_R.size(); ++i) {
+        file << config.grid_R[i];
+        if (i < config.grid_R.size() - 1) file << ", ";
+    }
+    file << "],\n";
+    file << "  \"grid_P\": [";
+    for (size_t i = 0; i < config.grid_P.size(); ++i) {
+        file << config.grid_P[i];
+        if (i < config.grid_P.size() - 1) file << ", ";
+    }
+    file << "],\n";
+    file << "  \"grid_S\": [";
+    for (size_t i = 0; i < config.grid_S.size(); ++i) {
+        file << config.grid_S[i];
+        if (i < config.grid_S.size() - 1) file << ", ";
+    }
+    file << "]\n";
     
     file << "}\n";
     
@@ -214,6 +282,67 @@ std::vector<std::string> ConfigIO::parseJsonStringArray(const std::string& json,
     return result;
 }
 
+void ConfigIO::validateConfig(const Config& config) {
+    auto range = [](const char* field, double value, double low, double high) {
+        if (value < low || value > high) {
+            std::ostringstream message;
+            message << field << " must be between " << low << " and " << high << ", got " << value;
+            throw std::runtime_error(message.str());
+        }
+    };
+    auto atLeast = [](const char* field, double value, double low) {
+        if (value < low) {
+            std::ostringstream message;
+            message << field << " must be at least " << low << ", got " << value;
+            throw std::runtime_error(message.str());
+        }
+    };
+    auto member = [](const char* field, const std::string& value, std::initializer_list<const char*> allowed) {
+        for (const char* name : allowed) {
+            if (value == name) return;
+        }
+        throw std::runtime_error(std::string(field) + " has unknown value '" + value + "'");
+    };
+
+    // Tournament and evolution
+    atLeast("ci_target", config.ci_target, 0.0);
+    atLeast("max_repeats", config.max_repeats, 1);
+    atLeast("payoff_refresh", config.payoff_refresh, 0);
+    atLeast("convergence_tol", config.convergence_tol, 0.0);
+    member("replicator", config.replicator, { "discrete", "rk45" });
+
+    // Finite population
+    if (!config.finite.empty()) member("finite", config.finite, { "moran", "wright-fisher" });
+    range("population", config.population, 2, 1 << 30);
+    atLeast("trajectories", config.trajectories, 1);
+    atLeast("fixation_generations", config.fixation_generations, 1);
+
+    // Spatial lattice: 0 is off, and a torus needs at least 3 cells a side
+    if (config.lattice != 0) range("lattice (0 = off)", config.lattice, 3, 4096);
+    member("neighborhood", config.neighborhood, { "moore", "von-neumann" });
+    atLeast("snapshot_every", config.snapshot_every, 0);
+
+    // Graph evolution
+    range("graph_nodes", config.graph_nodes, 3, 2000000000);
+    range("graph_degree", config.graph_degree, 2, 100000);
+    range("rewire", config.rewire, 0.0, 1.0);
+    member("graph_update", config.graph_update, { "sync", "async" });
+
+    // Island model
+    range("islands", config.islands, 0, 65536);
+    atLeast("migration_every", config.migration_every, 1);
+    range("migration_rate", config.migration_rate, 0.0, 1.0);
+
+    // Genetic search
+    range("optimize_depth", config.optimize_depth, 1, LookupTableStrategy::MAX_DEPTH);
+    range("ga_population", config.ga_population, 2, 100000);
+    range("mutation_rate", config.mutation_rate, 0.0, 1.0);
+
+    // Performance
+    atLeast("threads", config.threads, 0);
+    member("rng", config.rng, { "mt19937", "xoshiro256pp", "pcg32", "philox" });
+}
+
 Config ConfigIO::loadConfig(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -231,6 +360,12 @@ Config ConfigIO::loadConfig(const std::string& filename) {
     try {
         config.rounds = parseJsonInt(json, "rounds");
         config.repeats = parseJsonInt(json, "repeats");
+        if (json.find("\"ci_target\"") != std::string::npos) {
+            config.ci_target = parseJsonDouble(json, "ci_target");
+        }
+        if (json.find("\"max_repeats\"") != std::string::npos) {
+            config.max_repeats = parseJsonInt(json, "max_repeats");
+        }
         config.epsilon = parseJsonDouble(json, "epsilon");
         config.seed = parseJsonInt(json, "seed");
         
@@ -250,15 +385,107 @@ Config ConfigIO::loadConfig(const std::string& filename) {
         
         config.evolve = parseJsonBool(json, "evolve");
         config.generations = parseJsonInt(json, "generations");
+        if (json.find("\"payoff_refresh\"") != std::string::npos) {
+            config.payoff_refresh = parseJsonInt(json, "payoff_refresh");
+        }
+        std::string replicator = parseJsonString(json, "replicator");
+        if (!replicator.empty()) config.replicator = replicator;
+        if (json.find("\"convergence_tol\"") != std::string::npos) {
+            config.convergence_tol = parseJsonDouble(json, "convergence_tol");
+        }
+
+        // Finite population parameters are optional; keep the defaults when a file has none
+        config.finite = parseJsonString(json, "finite");
+        if (json.find("\"population\"") != std::string::npos) {
+            config.population = parseJsonInt(json, "population");
+        }
+        if (json.find("\"trajectories\"") != std::string::npos) {
+            config.trajectories = parseJsonInt(json, "trajectories");
+        }
+        if (json.find("\"selection\"") != std::string::npos) {
+            config.selection = parseJsonDouble(json, "selection");
+        }
+        if (json.find("\"fixation_generations\"") != std::string::npos) {
+            config.fixation_generations = parseJsonInt(json, "fixation_generations");
+        }
+
+        // Spatial lattice parameters are optional as well
+        if (json.find("\"lattice\"") != std::string::npos) {
+            config.lattice = parseJsonInt(json, "lattice");
+        }
+        std::string neighborhood = parseJsonString(json, "neighborhood");
+        if (!neighborhood.empty()) config.neighborhood = neighborhood;
+        if (json.find("\"snapshot_every\"") != std::string::npos) {
+            config.snapshot_every = parseJsonInt(json, "snapshot_every");
+        }
+
+        // Graph evolution parameters are optional as well
+        config.graph = parseJsonString(json, "graph");
+        if (json.find("\"graph_nodes\"") != std::string::npos) {
+            config.graph_nodes = parseJsonInt(json, "graph_nodes");
+        }
+        if (json.find("\"graph_degree\"") != std::string::npos) {
+            config.graph_degree = parseJsonInt(json, "graph_degree");
+        }
+        if (json.find("\"rewire\"") != std::string::npos) {
+            config.rewire = parseJsonDouble(json, "rewire");
+        }
+        std::string graph_update = parseJsonString(json, "graph_update");
+        if (!graph_update.empty()) config.graph_update = graph_update;
+
+        // Island model parameters are optional as well
+        if (json.find("\"islands\"") != std::string::npos) {
+            config.islands = parseJsonInt(json, "islands");
+        }
+        if (json.find("\"migration_every\"") != std::string::npos) {
+            config.migration_every = parseJsonInt(json, "migration_every");
+        }
+        if (json.find("\"migration_rate\"") != std::string::npos) {
+            config.migration_rate = parseJsonDouble(json, "migration_rate");
+        }
+
+        // So are the genetic search parameters
+        config.optimize = parseJsonBool(json, "optimize");
+        if (json.find("\"optimize_depth\"") != std::string::npos) {
+            config.optimize_depth = parseJsonInt(json, "optimize_depth");
+        }
+        if (json.find("\"ga_population\"") != std::string::npos) {
+            config.ga_population = parseJsonInt(json, "ga_population");
+        }
+        if (json.find("\"mutation_rate\"") != std::string::npos) {
+            config.mutation_rate = parseJsonDouble(json, "mutation_rate");
+        }
         
         config.enable_scb = parseJsonBool(json, "enable_scb");
         config.scb_cost_factor = parseJsonDouble(json, "scb_cost_factor");
         config.scb_compare = parseJsonBool(json, "scb_compare");
+
+        config.exact = parseJsonBool(json, "exact");
+        std::string rng = parseJsonString(json, "rng");
+        if (!rng.empty()) config.rng = rng;
+
+        // Grid axes are optional; keep the defaults when a file has none
+        config.payoff_grid = parseJsonBool(json, "payoff_grid");
+        std::vector<double> grid_T = parseJsonDoubleArray(json, "grid_T");
+        std::vector<double> grid_R = parseJsonDoubleArray(json, "grid_R");
+        std::vector<double> grid_P = parseJsonDoubleArray(json, "grid_P");
+        std::vector<double> grid_S = parseJsonDoubleArray(json, "grid_S");
+        if (!grid_T.empty()) config.grid_T = grid_T;
+        if (!grid_R.empty()) config.grid_R = grid_R;
+        if (!grid_P.empty()) config.grid_P = grid_P;
+        if (!grid_S.empty()) config.grid_S = grid_S;
     }
     catch (const std::exception& e) {
         throw std::runtime_error("Error parsing JSON config file: " + std::string(e.what()));
     }
     
+    try {
+        validateConfig(config);
+    }
+    catch (const std::exception& e) {
+        throw std::runtime_error("Invalid config file " + filename + ": " + e.what());
+    }
+
     std::cout << "Configuration loaded from: " << filename << std::endl;
     return config;
 }
@@ -18,6 +18,10 @@ public:
     
     // Load configuration from JSON file
     static Config loadConfig(const std::string& filename);
+
+    // Check value ranges and option names; throws std::runtime_error naming the first bad field.
+    // Run on loaded files and on the final command-line configuration alike.
+    static void validateConfig(const Config& config);
     
 private:
     // Helper to escape JSON strings
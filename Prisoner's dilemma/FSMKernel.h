@@ -0,0 +1,121 @@
+﻿#ifndef FSMKERNEL_H
+#define FSMKERNEL_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "Strategy.h"
+#include "StrategyFSM.h"
+#include "PayoffMatrix.h"
+#include "OutcomeCounts.h"
+
+/**
+ * @brief Table-driven match engine for two finite-state-machine strategies
+ * @tparam ScoreType The type used for scores
+ *
+ * Both machines are compiled into one table over a joint-state byte
+ * (player 1's state in the low nibble, player 2's in the high nibble).
+ * A round is then a couple of table loads: no virtual calls and no history.
+ * Build one kernel per pairing and reuse it for every repeat.
+ *
+ * Without noise the joint state must repeat within 256 rounds; from then on the
+ * match is periodic and the remaining rounds are counted per whole cycle.
+ */
+template<typename ScoreType = double>
+class FSMKernel {
+private:
+    static constexpr int JOINT_STATES = 256;
+
+    std::uint8_t initial_ = 0;
+    std::array<std::uint8_t, JOINT_STATES> intended_{};         // joint state -> intended outcome code (player 1's view)
+    std::array<std::uint8_t, JOINT_STATES> next_clean_{};       // joint state -> next joint state when nothing is flipped
+    std::array<std::uint8_t, JOINT_STATES * 4> transition_{};   // joint state x actual outcome -> next joint state
+    PayoffMatrix<ScoreType> payoffs_;
+
+    // Swap the two move bits of an outcome code (player 1's view <-> player 2's view)
+    static std::uint8_t mirror(std::uint8_t code) {
+        return static_cast<std::uint8_t>((code >> 1) | ((code & 1u) << 1));
+    }
+
+    static std::uint8_t joint(std::uint8_t s1, std::uint8_t s2) {
+        return static_cast<std::uint8_t>(s1 | (s2 << 4));
+    }
+
+public:
+    FSMKernel(const StrategyFSM& fsm1, const StrategyFSM& fsm2, const PayoffMatrix<ScoreType>& payoffs)
+        : payoffs_(payoffs) {
+        initial_ = joint(fsm1.initial_state, fsm2.initial_state);
+
+        for (std::uint8_t s1 = 0; s1 < fsm1.num_states; ++s1) {
+            for (std::uint8_t s2 = 0; s2 < fsm2.num_states; ++s2) {
+                std::uint8_t j = joint(s1, s2);
+                intended_[j] = static_cast<std::uint8_t>(
+                    static_cast<unsigned>(fsm1.output[s1]) | (static_cast<unsigned>(fsm2.output[s2]) << 1));
+                for (std::uint8_t code = 0; code < 4; ++code) {
+                    transition_[j * 4 + code] = joint(fsm1.next[s1][code], fsm2.next[s2][mirror(code)]);
+                }
+                next_clean_[j] = transition_[j * 4 + intended_[j]];
+            }
+        }
+    }
+
+    // Count the outcomes of one match. Noise flips are drawn through each strategy's
+    // applyNoise in the same order as Simulator's generic loop, so the results are identical to it.
+    // The machines carry the rule state themselves; the match states only supply the noise streams.
+    OutcomeCounts count(const Strategy& p1, const Strategy& p2, StrategyState& match1, StrategyState& match2,
+                        double noise, int rounds) const {
+        OutcomeCounts counts;
+        std::uint8_t state = initial_;
+
+        if (noise == 0.0) {
+            // first_seen[j]: round at which joint state j was entered, -1 if not yet
+            std::array<std::int16_t, JOINT_STATES> first_seen;
+            first_seen.fill(-1);
+            std::array<std::uint8_t, JOINT_STATES> codes; // outcome of each round before the repeat
+
+            int i = 0;
+            for (; i < rounds; ++i) {
+                if (first_seen[state] >= 0) break;
+                first_seen[state] = static_cast<std::int16_t>(i);
+                codes[i] = intended_[state];
+                counts.add(codes[i]);
+                state = next_clean_[state];
+            }
+
+            if (i < rounds) {
+                // Rounds [start, i) form a cycle; count the rest as whole cycles plus a partial one
+                int start = first_seen[state];
+                int period = i - start;
+                int remaining = rounds - i;
+                OutcomeCounts cycle, tail;
+                for (int r = start; r < i; ++r) {
+                    cycle.add(codes[r]);
+                    if (r - start < remaining % period) tail.add(codes[r]);
+                }
+                counts += cycle * static_cast<double>(remaining / period);
+                counts += tail;
+            }
+        }
+        else {
+            for (int i = 0; i < rounds; ++i) {
+                std::uint8_t code = intended_[state];
+                Move m1 = p1.applyNoise(static_cast<Move>(code & 1u), noise, match1);
+                Move m2 = p2.applyNoise(static_cast<Move>(code >> 1), noise, match2);
+                code = static_cast<std::uint8_t>(static_cast<unsigned>(m1) | (static_cast<unsigned>(m2) << 1));
+                counts.add(code);
+                state = transition_[state * 4 + code];
+            }
+        }
+
+        return counts;
+    }
+
+    // Play one match and score it with the kernel's payoff matrix
+    std::pair<ScoreType, ScoreType> play(const Strategy& p1, const Strategy& p2,
+                                         StrategyState& match1, StrategyState& match2,
+                                         double noise, int rounds) const {
+        return count(p1, p2, match1, match2, noise, rounds).score(payoffs_);
+    }
+};
+
+#endif // FSMKERNEL_H
@@ -0,0 +1,255 @@
+﻿#ifndef FINITEPOPULATION_H
+#define FINITEPOPULATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Random.h"
+
+/**
+ * @brief Stochastic update rule of a finite population
+ *   MORAN         - one birth-death event at a time: a parent chosen proportional to fitness
+ *                   copies its strategy onto a uniformly chosen agent; N events make a generation
+ *   WRIGHT_FISHER - the whole population is replaced every generation by N offspring whose
+ *                   parents are drawn proportional to fitness
+ */
+enum class FiniteProcess {
+    MORAN,
+    WRIGHT_FISHER
+};
+
+inline std::string finiteProcessName(FiniteProcess process) {
+    return process == FiniteProcess::WRIGHT_FISHER ? "wright-fisher" : "moran";
+}
+
+inline FiniteProcess parseFiniteProcess(const std::string& name) {
+    if (name == "moran") return FiniteProcess::MORAN;
+    if (name == "wright-fisher") return FiniteProcess::WRIGHT_FISHER;
+    throw std::invalid_argument("Unknown finite-population process: " + name);
+}
+
+/**
+ * @brief Walker alias table: draws index i with probability weights[i] / sum in O(1)
+ *
+ * Built in O(k) with Vose's method.
+ */
+class AliasTable {
+private:
+    std::vector<double> prob_;
+    std::vector<std::uint32_t> alias_;
+
+public:
+    void build(const std::vector<double>& weights) {
+        const std::size_t k = weights.size();
+        double total = 0.0;
+        for (double w : weights) total += w;
+        if (k == 0 || !(total > 0.0)) throw std::invalid_argument("Alias table needs a positive total weight");
+
+        prob_.assign(k, 0.0);
+        alias_.assign(k, 0);
+        std::vector<double> scaled(k);
+        std::vector<std::uint32_t> small, large;
+        for (std::size_t i = 0; i < k; ++i) {
+            scaled[i] = weights[i] * k / total;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+        while (!small.empty() && !large.empty()) {
+            std::uint32_t s = small.back(); small.pop_back();
+            std::uint32_t l = large.back(); large.pop_back();
+            prob_[s] = scaled[s];
+            alias_[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            (scaled[l] < 1.0 ? small : large).push_back(l);
+        }
+        // Leftovers are 1 up to rounding
+        for (std::uint32_t i : small) prob_[i] = 1.0;
+        for (std::uint32_t i : large) prob_[i] = 1.0;
+    }
+
+    template<typename Engine>
+    std::uint32_t sample(Engine& engine) const {
+        double u = uniformClosedOpen(engine) * prob_.size();
+        std::size_t column = std::min(static_cast<std::size_t>(u), prob_.size() - 1);
+        return u - column < prob_[column] ? static_cast<std::uint32_t>(column) : alias_[column];
+    }
+};
+
+/**
+ * @brief Fixation of strategies in a finite, well-mixed population
+ *
+ * payoffs[i][j] is the average payoff per round of strategy i against strategy j. An
+ * agent's payoff is its average over the other N - 1 agents and its fitness is
+ * exp(selection * payoff), so selection = 0 is neutral drift. Matches are already
+ * averaged into the payoff matrix, so an agent is just its strategy type: 2 bytes,
+ * 2 MB for a million agents.
+ *
+ * A Moran parent is found by rejection: draw a uniform agent and keep it with
+ * probability fitness / max fitness, O(1) expected per event since fitness varies by at
+ * most exp(selection * payoff range). Every event changes the fitness of every type, so
+ * a sum tree over the types would need O(k log k) updates per event. Wright-Fisher
+ * draws each generation's N parents from an alias table built once per generation.
+ */
+class FinitePopulation {
+public:
+    struct Outcome {
+        int fixed_type = -1;          // type that took over the population, -1 if none within the cap
+        long long generations = 0;    // generations until fixation (or the cap)
+    };
+
+    // Wilson score interval of a binomial proportion (z = 1.96 for 95%)
+    static std::pair<double, double> wilsonInterval(long long successes, long long trials, double z = 1.96) {
+        if (trials <= 0) return { 0.0, 1.0 };
+        double n = static_cast<double>(trials);
+        double p = successes / n;
+        double denominator = 1.0 + z * z / n;
+        double center = (p + z * z / (2.0 * n)) / denominator;
+        double margin = z * std::sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / denominator;
+        return { std::max(0.0, center - margin), std::min(1.0, center + margin) };
+    }
+
+private:
+    std::size_t k_;
+    std::vector<double> payoffs_; // k x k, row-major
+    FiniteProcess process_;
+    int population_;
+    double selection_;
+
+    // Payoff sums sum_j payoffs[i][j] * counts[j], including the agent itself
+    void payoffSums(const std::vector<int>& counts, std::vector<double>& sums) const {
+        sums.assign(k_, 0.0);
+        for (std::size_t i = 0; i < k_; ++i) {
+            const double* row = &payoffs_[i * k_];
+            for (std::size_t j = 0; j < k_; ++j) sums[i] += row[j] * counts[j];
+        }
+    }
+
+    // Fitness of each type present; returns the largest
+    double fitness(const std::vector<int>& counts, const std::vector<double>& sums, std::vector<double>& fit) const {
+        fit.assign(k_, 0.0);
+        double largest = 0.0;
+        const double others = population_ > 1 ? population_ - 1.0 : 1.0;
+        for (std::size_t i = 0; i < k_; ++i) {
+            if (counts[i] == 0) continue;
+            double payoff = (sums[i] - payoffs_[i * k_ + i]) / others;
+            fit[i] = std::exp(selection_ * payoff);
+            largest = std::max(largest, fit[i]);
+        }
+        return largest;
+    }
+
+    static int fixedType(const std::vector<int>& counts, int population) {
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] == population) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    template<typename Engine>
+    Outcome runMoran(std::vector<int>& counts, long long max_generations, Engine& engine) const {
+        std::vector<std::uint16_t> agents;
+        agents.reserve(population_);
+        for (std::size_t i = 0; i < k_; ++i) agents.insert(agents.end(), counts[i], static_cast<std::uint16_t>(i));
+
+        std::vector<double> sums, fit;
+        Outcome outcome;
+        for (; outcome.generations < max_generations; ++outcome.generations) {
+            // Refresh the sums once per generation so rounding cannot build up
+            payoffSums(counts, sums);
+            double largest = fitness(counts, sums, fit);
+
+            for (int event = 0; event < population_; ++event) {
+                std::uint16_t parent;
+                do {
+                    parent = agents[uniformIndex(engine, agents.size())];
+                } while (uniformClosedOpen(engine) * largest >= fit[parent]);
+
+                std::uint16_t& victim = agents[uniformIndex(engine, agents.size())];
+                if (victim == parent) continue;
+
+                const std::uint16_t dead = victim;
+                victim = parent;
+                ++counts[parent];
+                --counts[dead];
+                if (counts[parent] == population_) {
+                    outcome.fixed_type = parent;
+                    ++outcome.generations;
+                    return outcome;
+                }
+                for (std::size_t i = 0; i < k_; ++i) {
+                    sums[i] += payoffs_[i * k_ + parent] - payoffs_[i * k_ + dead];
+                }
+                largest = fitness(counts, sums, fit);
+            }
+        }
+        return outcome;
+    }
+
+    template<typename Engine>
+    Outcome runWrightFisher(std::vector<int>& counts, long long max_generations, Engine& engine) const {
+        std::vector<double> sums, fit, weights(k_);
+        std::vector<int> next(k_);
+        AliasTable parents;
+        Outcome outcome;
+        while (outcome.generations < max_generations) {
+            payoffSums(counts, sums);
+            fitness(counts, sums, fit);
+            for (std::size_t i = 0; i < k_; ++i) weights[i] = counts[i] * fit[i];
+            parents.build(weights);
+
+            std::fill(next.begin(), next.end(), 0);
+            for (int agent = 0; agent < population_; ++agent) ++next[parents.sample(engine)];
+            counts.swap(next);
+            ++outcome.generations;
+
+            outcome.fixed_type = fixedType(counts, population_);
+            if (outcome.fixed_type >= 0) break;
+        }
+        return outcome;
+    }
+
+public:
+    FinitePopulation(const std::vector<std::vector<double>>& payoffs, FiniteProcess process,
+                     int population, double selection)
+        : k_(payoffs.size()), payoffs_(k_ * k_), process_(process),
+          population_(population), selection_(selection) {
+        if (population_ < 2) throw std::invalid_argument("Population must have at least 2 agents");
+        if (k_ > 65536) throw std::invalid_argument("At most 65536 strategy types");
+        for (std::size_t i = 0; i < k_; ++i) {
+            if (payoffs[i].size() != k_) throw std::invalid_argument("Payoff matrix must be square");
+            std::copy(payoffs[i].begin(), payoffs[i].end(), payoffs_.begin() + i * k_);
+        }
+    }
+
+    int population() const { return population_; }
+    FiniteProcess process() const { return process_; }
+
+    // Evolve the number of agents of each type (summing to the population size) in place
+    // until one type has taken over or max_generations have passed
+    template<typename Engine>
+    Outcome advance(std::vector<int>& counts, long long max_generations, Engine& engine) const {
+        long long total = 0;
+        for (int c : counts) total += c;
+        if (counts.size() != k_ || total != population_) {
+            throw std::invalid_argument("Counts must cover every type and sum to the population size");
+        }
+
+        Outcome outcome;
+        outcome.fixed_type = fixedType(counts, population_);
+        if (outcome.fixed_type >= 0) return outcome;
+        return process_ == FiniteProcess::MORAN ? runMoran(counts, max_generations, engine)
+                                                : runWrightFisher(counts, max_generations, engine);
+    }
+
+    // One trajectory from the given counts, leaving them unchanged
+    template<typename Engine>
+    Outcome run(std::vector<int> counts, long long max_generations, Engine& engine) const {
+        return advance(counts, max_generations, engine);
+    }
+};
+
+#endif // FINITEPOPULATION_H
@@ -0,0 +1,139 @@
+﻿#ifndef GENETICOPTIMIZER_H
+#define GENETICOPTIMIZER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Random.h"
+
+/// Fittest genome of one generation of the genetic search (--optimize)
+struct OptimizationStep {
+    int generation = 0;
+    std::string best;            // strategy name of the fittest genome
+    double best_fitness = 0.0;
+    double mean_fitness = 0.0;
+    std::size_t scored = 0;      // genomes scored this generation; the others came from the cache
+};
+
+/**
+ * @brief Genetic algorithm over fixed-length bit strings
+ *
+ * Every generation keeps the `elite` fittest genomes unchanged and refills the population
+ * with children of two elites drawn uniformly: one-point crossover, then every bit flips
+ * with probability mutation_rate, as in Axelrod's search over memory-3 lookup tables.
+ * The caller scores a whole generation at once, so it can spread the work over threads.
+ * Fitness is cached by genome and must therefore depend on the genome alone: elites and
+ * children equal to an earlier genome are never scored twice.
+ */
+class GeneticOptimizer {
+public:
+    using Genome = std::vector<std::uint8_t>; // one bit per byte
+
+private:
+    std::size_t bits_;
+    std::size_t elite_;
+    double mutation_rate_;
+    std::vector<Genome> population_;
+    std::vector<double> fitness_;                   // of the current population, after evaluate()
+    std::unordered_map<std::string, double> cache_; // packed genome -> fitness
+    std::size_t cache_hits_ = 0;
+
+    static std::string pack(const Genome& genome) {
+        std::string packed((genome.size() + 7) / 8, '\0');
+        for (std::size_t b = 0; b < genome.size(); ++b) {
+            if (genome[b]) packed[b / 8] = static_cast<char>(packed[b / 8] | (1 << (b % 8)));
+        }
+        return packed;
+    }
+
+public:
+    GeneticOptimizer(std::size_t bits, std::size_t population, std::size_t elite, double mutation_rate)
+        : bits_(bits), elite_(elite), mutation_rate_(mutation_rate), population_(population, Genome(bits, 0)) {
+        if (bits_ == 0) throw std::invalid_argument("Genomes need at least one bit");
+        if (population < 2) throw std::invalid_argument("Genetic search needs at least 2 genomes");
+        if (elite_ < 1 || elite_ >= population) throw std::invalid_argument("Elite must keep between 1 and population - 1 genomes");
+    }
+
+    const std::vector<Genome>& population() const { return population_; }
+    const std::vector<double>& fitness() const { return fitness_; }
+    std::size_t cacheSize() const { return cache_.size(); }
+    std::size_t cacheHits() const { return cache_hits_; }
+
+    // Fill the population with uniformly random genomes
+    template<typename Engine>
+    void randomize(Engine& engine) {
+        for (auto& genome : population_) {
+            for (auto& bit : genome) bit = uniformClosedOpen(engine) < 0.5 ? 1 : 0;
+        }
+        fitness_.clear();
+    }
+
+    // Fitness of the current population. score(genomes, fitness) must fill fitness[g] for
+    // every genome passed, which are the distinct genomes not cached yet. Returns their number.
+    template<typename Score>
+    std::size_t evaluate(Score&& score) {
+        std::vector<std::string> keys(population_.size());
+        std::vector<Genome> missing;
+        std::vector<std::string> missing_keys;
+        std::unordered_set<std::string> pending;
+        for (std::size_t g = 0; g < population_.size(); ++g) {
+            keys[g] = pack(population_[g]);
+            if (cache_.count(keys[g]) || !pending.insert(keys[g]).second) {
+                ++cache_hits_;
+                continue;
+            }
+            missing.push_back(population_[g]);
+            missing_keys.push_back(keys[g]);
+        }
+
+        std::vector<double> scores(missing.size(), 0.0);
+        if (!missing.empty()) score(missing, scores);
+        for (std::size_t m = 0; m < missing.size(); ++m) cache_.emplace(missing_keys[m], scores[m]);
+
+        fitness_.resize(population_.size());
+        for (std::size_t g = 0; g < population_.size(); ++g) fitness_[g] = cache_.at(keys[g]);
+        return missing.size();
+    }
+
+    // Index of the fittest genome after evaluate(); ties go to the first
+    std::size_t best() const {
+        return static_cast<std::size_t>(std::max_element(fitness_.begin(), fitness_.end()) - fitness_.begin());
+    }
+
+    // Replace the population by the next generation; needs evaluate() first
+    template<typename Engine>
+    void breed(Engine& engine) {
+        if (fitness_.size() != population_.size()) throw std::logic_error("Evaluate the population before breeding it");
+
+        // Stable, so equally fit genomes keep their order and the run stays reproducible
+        std::vector<std::size_t> order(population_.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return fitness_[a] > fitness_[b]; });
+
+        std::vector<Genome> next;
+        next.reserve(population_.size());
+        for (std::size_t e = 0; e < elite_; ++e) next.push_back(population_[order[e]]);
+        while (next.size() < population_.size()) {
+            const Genome& mother = population_[order[uniformIndex(engine, elite_)]];
+            const Genome& father = population_[order[uniformIndex(engine, elite_)]];
+            std::size_t cut = uniformIndex(engine, bits_ + 1);
+            Genome child(mother.begin(), mother.begin() + cut);
+            child.insert(child.end(), father.begin() + cut, father.end());
+            for (auto& bit : child) {
+                if (uniformClosedOpen(engine) < mutation_rate_) bit ^= 1;
+            }
+            next.push_back(std::move(child));
+        }
+        population_.swap(next);
+        fitness_.clear();
+    }
+};
+
+#endif // GENETICOPTIMIZER_H
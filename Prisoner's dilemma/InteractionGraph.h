@@ -0,0 +1,318 @@
+﻿#ifndef INTERACTIONGRAPH_H
+#define INTERACTIONGRAPH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Random.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Undirected interaction network in compressed sparse row (CSR) form
+ *
+ * The neighbors of node v are neighbors[offsets[v] .. offsets[v + 1]), sorted, without
+ * self-loops or repeated edges. An edge takes 8 bytes (one 32-bit entry per direction),
+ * so a 10^7-edge graph needs about 80 MB plus 8 bytes per node.
+ */
+class InteractionGraph {
+private:
+    std::vector<std::uint64_t> offsets_;
+    std::vector<std::uint32_t> neighbors_;
+
+public:
+    InteractionGraph() : offsets_(1, 0) {}
+
+    // Build from a flat list of endpoint pairs (u0, v0, u1, v1, ...) over nodes [0, nodes)
+    static InteractionGraph fromEdges(std::uint32_t nodes, const std::vector<std::uint32_t>& endpoints) {
+        InteractionGraph graph;
+        graph.offsets_.assign(static_cast<std::size_t>(nodes) + 1, 0);
+        for (std::size_t e = 0; e + 1 < endpoints.size(); e += 2) {
+            std::uint32_t u = endpoints[e], v = endpoints[e + 1];
+            if (u >= nodes || v >= nodes) throw std::invalid_argument("Edge endpoint out of range");
+            if (u == v) continue;
+            ++graph.offsets_[u + 1];
+            ++graph.offsets_[v + 1];
+        }
+        for (std::size_t v = 0; v < nodes; ++v) graph.offsets_[v + 1] += graph.offsets_[v];
+
+        graph.neighbors_.resize(graph.offsets_[nodes]);
+        std::vector<std::uint64_t> fill(graph.offsets_.begin(), graph.offsets_.end() - 1);
+        for (std::size_t e = 0; e + 1 < endpoints.size(); e += 2) {
+            std::uint32_t u = endpoints[e], v = endpoints[e + 1];
+            if (u == v) continue;
+            graph.neighbors_[fill[u]++] = v;
+            graph.neighbors_[fill[v]++] = u;
+        }
+
+        // Sort each list and drop repeated edges, compacting in place
+        std::uint64_t write = 0;
+        for (std::size_t v = 0; v < nodes; ++v) {
+            auto begin = graph.neighbors_.begin() + graph.offsets_[v];
+            auto end = graph.neighbors_.begin() + graph.offsets_[v + 1];
+            std::sort(begin, end);
+            end = std::unique(begin, end);
+            graph.offsets_[v] = write;
+            write = std::copy(begin, end, graph.neighbors_.begin() + write) - graph.neighbors_.begin();
+        }
+        graph.offsets_[nodes] = write;
+        graph.neighbors_.resize(write);
+        graph.neighbors_.shrink_to_fit();
+        return graph;
+    }
+
+    // Watts-Strogatz small world: a ring where each node links to its `degree` nearest
+    // nodes, then each edge's far end is rewired to a uniform node with probability `rewire`
+    template<typename Engine>
+    static InteractionGraph smallWorld(std::uint32_t nodes, int degree, double rewire, Engine& engine) {
+        if (degree < 2 || degree % 2 != 0 || static_cast<std::uint32_t>(degree) >= nodes) {
+            throw std::invalid_argument("Small-world degree must be even and below the number of nodes");
+        }
+        std::vector<std::uint32_t> endpoints;
+        endpoints.reserve(static_cast<std::size_t>(nodes) * degree);
+        for (std::uint32_t u = 0; u < nodes; ++u) {
+            for (int d = 1; d <= degree / 2; ++d) {
+                std::uint32_t v = static_cast<std::uint32_t>((u + d) % nodes);
+                if (uniformClosedOpen(engine) < rewire) {
+                    do {
+                        v = static_cast<std::uint32_t>(uniformIndex(engine, nodes));
+                    } while (v == u);
+                }
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+        return fromEdges(nodes, endpoints);
+    }
+
+    // Barabasi-Albert scale-free graph: starting from a clique of degree / 2 + 1 nodes, every
+    // new node links to degree / 2 distinct nodes chosen proportional to their degree
+    template<typename Engine>
+    static InteractionGraph scaleFree(std::uint32_t nodes, int degree, Engine& engine) {
+        const std::uint32_t links = static_cast<std::uint32_t>(std::max(1, degree / 2));
+        if (links + 1 > nodes) throw std::invalid_argument("Scale-free graph needs more nodes than links per node");
+
+        // Every edge adds both endpoints, so a uniform entry of this list is a node drawn
+        // proportional to its degree
+        std::vector<std::uint32_t> endpoints;
+        endpoints.reserve(static_cast<std::size_t>(nodes) * links * 2);
+        for (std::uint32_t u = 0; u <= links; ++u) {
+            for (std::uint32_t v = u + 1; v <= links; ++v) {
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+        std::vector<std::uint32_t> targets;
+        for (std::uint32_t u = links + 1; u < nodes; ++u) {
+            targets.clear();
+            const std::size_t existing = endpoints.size();
+            while (targets.size() < links) {
+                std::uint32_t v = endpoints[uniformIndex(engine, existing)];
+                if (std::find(targets.begin(), targets.end(), v) == targets.end()) targets.push_back(v);
+            }
+            for (std::uint32_t v : targets) {
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+        return fromEdges(nodes, endpoints);
+    }
+
+    // Edge list file: one "u v" pair of node numbers per line, anything after it (such as
+    // a weight) ignored; blank lines and lines starting with '#' or '%' are skipped.
+    // Nodes are numbered from 0 to the largest id.
+    static InteractionGraph fromFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) throw std::runtime_error("Cannot open graph file: " + filename);
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::vector<std::uint32_t> endpoints;
+        std::uint64_t largest = 0;
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+            if (p < end && (*p == '#' || *p == '%')) {
+                while (p < end && *p != '\n') ++p;
+            }
+            int fields = 0;
+            while (p < end && *p != '\n') {
+                if (*p >= '0' && *p <= '9') {
+                    std::uint64_t id = 0;
+                    while (p < end && *p >= '0' && *p <= '9') id = id * 10 + static_cast<std::uint64_t>(*p++ - '0');
+                    if (id > 0xFFFFFFFEull) throw std::runtime_error("Node id too large in " + filename);
+                    endpoints.push_back(static_cast<std::uint32_t>(id));
+                    largest = std::max(largest, id);
+                    if (++fields == 2) {
+                        while (p < end && *p != '\n') ++p;
+                    }
+                }
+                else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',') {
+                    ++p;
+                }
+                else {
+                    throw std::runtime_error("Unexpected character in graph file " + filename);
+                }
+            }
+            if (fields == 1) throw std::runtime_error("Line with a single node id in graph file " + filename);
+            ++p;
+        }
+        if (endpoints.empty()) throw std::runtime_error("No edges in graph file " + filename);
+        return fromEdges(static_cast<std::uint32_t>(largest + 1), endpoints);
+    }
+
+    std::uint32_t nodes() const { return static_cast<std::uint32_t>(offsets_.size() - 1); }
+    std::uint64_t edges() const { return neighbors_.size() / 2; }
+    std::uint64_t degree(std::uint32_t v) const { return offsets_[v + 1] - offsets_[v]; }
+    const std::uint32_t* begin(std::uint32_t v) const { return neighbors_.data() + offsets_[v]; }
+    const std::uint32_t* end(std::uint32_t v) const { return neighbors_.data() + offsets_[v + 1]; }
+
+    std::uint64_t maxDegree() const {
+        std::uint64_t largest = 0;
+        for (std::uint32_t v = 0; v < nodes(); ++v) largest = std::max(largest, degree(v));
+        return largest;
+    }
+
+    std::size_t bytes() const {
+        return offsets_.size() * sizeof(std::uint64_t) + neighbors_.size() * sizeof(std::uint32_t);
+    }
+};
+
+/**
+ * @brief How nodes of a graph adopt their neighbors' strategies
+ *   SYNC  - every node copies its best-scoring neighbor at once (ties keep their own)
+ *   ASYNC - N times per generation a random node picks a random neighbor and copies it
+ *           with Fermi probability 1 / (1 + exp(-selection * (their payoff - own payoff)))
+ */
+enum class GraphUpdate {
+    SYNC,
+    ASYNC
+};
+
+inline GraphUpdate parseGraphUpdate(const std::string& name) {
+    if (name == "sync") return GraphUpdate::SYNC;
+    if (name == "async") return GraphUpdate::ASYNC;
+    throw std::invalid_argument("Unknown graph update rule: " + name);
+}
+
+/**
+ * @brief Strategies on the nodes of an InteractionGraph
+ *
+ * payoffs[i][j] is the average payoff per round of strategy i against strategy j; a node's
+ * payoff is the sum over its neighbors, so well-connected nodes collect more. Payoffs of
+ * all nodes are computed in parallel blocks; synchronous updates also choose the next
+ * strategies in parallel into a second buffer. Asynchronous updates are sequential and
+ * keep the payoffs current by adjusting the changed node and its neighbors only.
+ */
+class GraphEvolution {
+private:
+    static constexpr std::size_t BLOCK = 4096; // nodes per parallel task
+
+    const InteractionGraph& graph_;
+    std::size_t k_;
+    std::vector<double> payoffs_; // k x k, row-major
+    std::vector<std::uint16_t> type_;
+    std::vector<std::uint16_t> next_type_;
+    std::vector<double> payoff_;
+
+    template<typename Work>
+    void forEachBlock(ThreadPool* pool, Work&& work) {
+        const std::size_t n = graph_.nodes();
+        auto run = [&](std::size_t block) {
+            std::uint32_t first = static_cast<std::uint32_t>(block * BLOCK);
+            std::uint32_t last = static_cast<std::uint32_t>(std::min(n, (block + 1) * BLOCK));
+            for (std::uint32_t v = first; v < last; ++v) work(v);
+        };
+        const std::size_t blocks = (n + BLOCK - 1) / BLOCK;
+        if (pool) {
+            pool->parallelFor(blocks, run);
+        }
+        else {
+            for (std::size_t block = 0; block < blocks; ++block) run(block);
+        }
+    }
+
+    double nodePayoff(std::uint32_t v) const {
+        const double* row = &payoffs_[type_[v] * k_];
+        double payoff = 0.0;
+        for (const std::uint32_t* u = graph_.begin(v); u != graph_.end(v); ++u) payoff += row[type_[*u]];
+        return payoff;
+    }
+
+public:
+    GraphEvolution(const InteractionGraph& graph, const std::vector<std::vector<double>>& payoffs)
+        : graph_(graph), k_(payoffs.size()), payoffs_(k_ * k_),
+          type_(graph.nodes(), 0), next_type_(graph.nodes(), 0), payoff_(graph.nodes(), 0.0) {
+        if (k_ == 0 || k_ > 65536) throw std::invalid_argument("Graph evolution needs between 1 and 65536 strategies");
+        for (std::size_t i = 0; i < k_; ++i) {
+            if (payoffs[i].size() != k_) throw std::invalid_argument("Payoff matrix must be square");
+            std::copy(payoffs[i].begin(), payoffs[i].end(), payoffs_.begin() + i * k_);
+        }
+    }
+
+    // Give every node a uniformly random strategy
+    template<typename Engine>
+    void randomize(Engine& engine) {
+        for (auto& type : type_) type = static_cast<std::uint16_t>(uniformIndex(engine, k_));
+    }
+
+    // Recompute every node's payoff against its neighbors
+    void computePayoffs(ThreadPool* pool) {
+        forEachBlock(pool, [this](std::uint32_t v) { payoff_[v] = nodePayoff(v); });
+    }
+
+    // One generation of best-neighbor imitation, all nodes at once
+    void syncStep(ThreadPool* pool) {
+        computePayoffs(pool);
+        forEachBlock(pool, [this](std::uint32_t v) {
+            double best = payoff_[v];
+            std::uint16_t type = type_[v];
+            for (const std::uint32_t* u = graph_.begin(v); u != graph_.end(v); ++u) {
+                if (payoff_[*u] > best) {
+                    best = payoff_[*u];
+                    type = type_[*u];
+                }
+            }
+            next_type_[v] = type;
+        });
+        type_.swap(next_type_);
+    }
+
+    // One generation of N random Fermi imitations
+    template<typename Engine>
+    void asyncStep(ThreadPool* pool, double selection, Engine& engine) {
+        computePayoffs(pool); // refreshed each generation so rounding cannot build up
+        const std::uint32_t n = graph_.nodes();
+        for (std::uint32_t update = 0; update < n; ++update) {
+            std::uint32_t v = static_cast<std::uint32_t>(uniformIndex(engine, n));
+            std::uint64_t d = graph_.degree(v);
+            if (d == 0) continue;
+            std::uint32_t model = graph_.begin(v)[uniformIndex(engine, d)];
+            if (type_[model] == type_[v]) continue;
+            double adopt = 1.0 / (1.0 + std::exp(-selection * (payoff_[model] - payoff_[v])));
+            if (uniformClosedOpen(engine) >= adopt) continue;
+
+            const std::uint16_t old_type = type_[v];
+            const std::uint16_t new_type = type_[model];
+            type_[v] = new_type;
+            for (const std::uint32_t* u = graph_.begin(v); u != graph_.end(v); ++u) {
+                payoff_[*u] += payoffs_[type_[*u] * k_ + new_type] - payoffs_[type_[*u] * k_ + old_type];
+            }
+            payoff_[v] = nodePayoff(v);
+        }
+    }
+
+    // Number of nodes holding each strategy
+    std::vector<long long> counts() const {
+        std::vector<long long> total(k_, 0);
+        for (std::uint16_t type : type_) ++total[type];
+        return total;
+    }
+};
+
+#endif // INTERACTIONGRAPH_H
@@ -0,0 +1,149 @@
+﻿#ifndef MATCHHISTORY_H
+#define MATCHHISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+enum class Move { Cooperate, Defect };
+
+class MatchHistory;
+
+/**
+ * @brief Read-only view of a match history from one player's perspective
+ *
+ * Behaves like the old std::vector<std::pair<Move, Move>> history:
+ * element i is {my move, opponent's move} in round i.
+ * When the underlying MatchHistory is a ring buffer, only the most recent
+ * window of rounds may be indexed. A view always refers to a MatchHistory
+ * (there is no empty view), so reads never check for a missing buffer.
+ */
+class History {
+private:
+    const MatchHistory* history_;
+    unsigned perspective_; // 0: player 1, 1: player 2
+
+public:
+    History(const MatchHistory& history, unsigned perspective)
+        : history_(&history), perspective_(perspective) {}
+
+    inline std::size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    // Two-bit outcome code of a round: bit 0 = I defected, bit 1 = opponent defected
+    inline unsigned outcome(std::size_t round) const;
+
+    std::pair<Move, Move> operator[](std::size_t round) const {
+        unsigned code = outcome(round);
+        return { static_cast<Move>(code & 1u), static_cast<Move>(code >> 1) };
+    }
+    std::pair<Move, Move> back() const {
+        unsigned code = lastOutcome();
+        return { static_cast<Move>(code & 1u), static_cast<Move>(code >> 1) };
+    }
+
+    // Outcome code of the most recent round (cached, no word lookup)
+    inline unsigned lastOutcome() const;
+};
+
+/**
+ * @brief Compact, reusable match history shared by both players
+ *
+ * Each round takes 2 bits (bit 0 = player 1 defected, bit 1 = player 2 defected),
+ * packed 32 rounds per 64-bit word. Both players read the same buffer through a
+ * History view; player 2's view swaps the two bits.
+ *
+ * With a finite window the buffer becomes a ring that keeps only the most recent
+ * rounds, so memory stays constant regardless of match length.
+ */
+class MatchHistory {
+public:
+    // Window value meaning "keep every round"
+    static constexpr std::size_t FULL_HISTORY = std::numeric_limits<std::size_t>::max();
+
+private:
+    static constexpr std::size_t ROUNDS_PER_WORD = 32;
+    static constexpr std::size_t MIN_RING_ROUNDS = 64;
+
+    std::vector<std::uint64_t> words_;
+    std::size_t rounds_ = 0;
+    std::size_t ring_mask_ = 0;  // slot = round & ring_mask_ when windowed
+    bool ring_ = false;
+    unsigned last_ = 0;          // outcome of the most recent round
+
+    std::size_t slotOf(std::size_t round) const {
+        return ring_ ? (round & ring_mask_) : round;
+    }
+
+public:
+    MatchHistory() = default;
+
+    // Start a new match. Keeps the allocated words so repeats do not reallocate.
+    // window: number of most recent rounds that must stay readable (FULL_HISTORY for all)
+    // expected_rounds: used to preallocate when the whole match is kept
+    void reset(std::size_t window = FULL_HISTORY, std::size_t expected_rounds = 0) {
+        rounds_ = 0;
+        ring_ = window != FULL_HISTORY;
+        if (ring_) {
+            std::size_t capacity = MIN_RING_ROUNDS;
+            while (capacity < window + 1) capacity <<= 1;
+            ring_mask_ = capacity - 1;
+            words_.assign(capacity / ROUNDS_PER_WORD, 0);
+        }
+        else {
+            ring_mask_ = 0;
+            words_.reserve((expected_rounds + ROUNDS_PER_WORD - 1) / ROUNDS_PER_WORD);
+        }
+    }
+
+    void push(Move move1, Move move2) {
+        std::uint64_t code = static_cast<std::uint64_t>(move1) | (static_cast<std::uint64_t>(move2) << 1);
+        std::size_t slot = slotOf(rounds_);
+        std::size_t word = slot / ROUNDS_PER_WORD;
+        unsigned shift = static_cast<unsigned>(slot % ROUNDS_PER_WORD) * 2;
+        if (word >= words_.size()) {
+            words_.push_back(0);
+        }
+        words_[word] = (words_[word] & ~(std::uint64_t(3) << shift)) | (code << shift);
+        ++rounds_;
+        last_ = static_cast<unsigned>(code);
+    }
+
+    std::size_t size() const { return rounds_; }
+    bool isWindowed() const { return ring_; }
+
+    // Two-bit outcome code of the most recent round from player 1's perspective
+    unsigned lastOutcome() const { return last_; }
+
+    // Two-bit outcome code from player 1's perspective
+    unsigned outcome(std::size_t round) const {
+        std::size_t slot = slotOf(round);
+        unsigned shift = static_cast<unsigned>(slot % ROUNDS_PER_WORD) * 2;
+        return static_cast<unsigned>(words_[slot / ROUNDS_PER_WORD] >> shift) & 3u;
+    }
+
+    History player1() const { return History(*this, 0); }
+    History player2() const { return History(*this, 1); }
+
+    // Bytes of history storage currently held
+    std::size_t memoryBytes() const { return words_.capacity() * sizeof(std::uint64_t); }
+};
+
+inline std::size_t History::size() const {
+    return history_->size();
+}
+
+inline unsigned History::outcome(std::size_t round) const {
+    unsigned code = history_->outcome(round);
+    // Player 2 sees the same round with the two moves swapped
+    return perspective_ ? ((code >> 1) | ((code & 1u) << 1)) : code;
+}
+
+inline unsigned History::lastOutcome() const {
+    unsigned code = history_->lastOutcome();
+    return perspective_ ? ((code >> 1) | ((code & 1u) << 1)) : code;
+}
+
+#endif // MATCHHISTORY_H
@@ -0,0 +1,127 @@
+﻿#ifndef MEMORYONECHAIN_H
+#define MEMORYONECHAIN_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "MatchHistory.h"
+#include "PayoffMatrix.h"
+#include "OutcomeCounts.h"
+
+/**
+ * @brief Memory-one form of a strategy: cooperation probabilities by last outcome
+ *
+ * cooperate[code] is the probability of cooperating after a round with outcome
+ * code (bit 0 = I defected, bit 1 = opponent defected); first is the probability
+ * of cooperating in round 1. Probabilities are intended moves, before noise.
+ */
+struct MemoryOneRule {
+    double first = 1.0;
+    std::array<double, 4> cooperate{};
+
+    // Rule that reacts only to the opponent's last move
+    static MemoryOneRule reactive(double first, double if_opp_cooperates, double if_opp_defects) {
+        MemoryOneRule rule;
+        rule.first = first;
+        rule.cooperate = { if_opp_cooperates, if_opp_cooperates, if_opp_defects, if_opp_defects };
+        return rule;
+    }
+};
+
+/**
+ * @brief Exact expected match scores for two memory-one strategies
+ * @tparam ScoreType The type used for scores
+ *
+ * With noise, play is a Markov chain over the four outcome codes of the last round.
+ * The expected total payoff over n rounds is v0 * (I + M + ... + M^(n-1)) * payoff,
+ * and the matrix sum is built by doubling in O(log n) 4x4 products.
+ */
+template<typename ScoreType = double>
+class MemoryOneChain {
+private:
+    using Matrix = std::array<std::array<double, 4>, 4>;
+
+    std::array<double, 4> initial_{}; // distribution of round 1's outcome
+    Matrix transition_{};             // outcome code -> next outcome code (player 1's view)
+    PayoffMatrix<ScoreType> payoffs_;
+
+    // Probability that a move intended as cooperation with probability p is played as C
+    static double withNoise(double p, double noise) {
+        return p * (1.0 - noise) + (1.0 - p) * noise;
+    }
+
+    static std::uint8_t mirror(std::uint8_t code) {
+        return static_cast<std::uint8_t>((code >> 1) | ((code & 1u) << 1));
+    }
+
+    // Distribution over outcome codes when each player cooperates independently
+    static std::array<double, 4> outcomes(double c1, double c2) {
+        return { c1 * c2, (1.0 - c1) * c2, c1 * (1.0 - c2), (1.0 - c1) * (1.0 - c2) };
+    }
+
+    static Matrix multiply(const Matrix& a, const Matrix& b) {
+        Matrix c{};
+        for (int i = 0; i < 4; ++i)
+            for (int k = 0; k < 4; ++k)
+                for (int j = 0; j < 4; ++j)
+                    c[i][j] += a[i][k] * b[k][j];
+        return c;
+    }
+
+    static Matrix add(const Matrix& a, const Matrix& b) {
+        Matrix c{};
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                c[i][j] = a[i][j] + b[i][j];
+        return c;
+    }
+
+    static Matrix identity() {
+        Matrix m{};
+        for (int i = 0; i < 4; ++i) m[i][i] = 1.0;
+        return m;
+    }
+
+public:
+    MemoryOneChain(const MemoryOneRule& rule1, const MemoryOneRule& rule2,
+                   double noise1, double noise2, const PayoffMatrix<ScoreType>& payoffs)
+        : payoffs_(payoffs) {
+        initial_ = outcomes(withNoise(rule1.first, noise1), withNoise(rule2.first, noise2));
+        for (std::uint8_t code = 0; code < 4; ++code) {
+            transition_[code] = outcomes(withNoise(rule1.cooperate[code], noise1),
+                                         withNoise(rule2.cooperate[mirror(code)], noise2));
+        }
+    }
+
+    // Expected number of rounds with each outcome over a match of `rounds` rounds
+    OutcomeCounts expectedCounts(long long rounds) const {
+        // Invariant: power = M^k, sum = I + M + ... + M^(k-1), for the k bits consumed so far
+        Matrix power = transition_;
+        Matrix sum = identity();
+        Matrix result_sum{};               // running sum over the rounds already covered
+        Matrix result_power = identity();  // M^(rounds covered)
+        for (long long n = rounds; n > 0; n >>= 1) {
+            if (n & 1) {
+                result_sum = add(result_sum, multiply(result_power, sum));
+                result_power = multiply(result_power, power);
+            }
+            sum = add(sum, multiply(sum, power)); // S(2k) = S(k) + S(k) * M^k
+            power = multiply(power, power);
+        }
+
+        OutcomeCounts counts;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                counts.rounds[j] += initial_[i] * result_sum[i][j];
+            }
+        }
+        return counts;
+    }
+
+    // Expected total scores of both players over a match of `rounds` rounds
+    std::pair<ScoreType, ScoreType> expectedScores(long long rounds) const {
+        return expectedCounts(rounds).score(payoffs_);
+    }
+};
+
+#endif // MEMORYONECHAIN_H
@@ -0,0 +1,68 @@
+﻿#ifndef OUTCOMECOUNTS_H
+#define OUTCOMECOUNTS_H
+
+#include <array>
+#include <utility>
+#include "MatchHistory.h"
+#include "PayoffMatrix.h"
+
+/**
+ * @brief Number of rounds of a match that ended in each outcome
+ *
+ * Indexed by outcome code from player 1's view (bit 0 = player 1 defected,
+ * bit 1 = player 2 defected). Strategies never read the payoffs, so these four
+ * counts determine the match score under any payoff matrix.
+ * Counts are doubles so expected (fractional) counts from --exact fit too.
+ */
+struct OutcomeCounts {
+    std::array<double, 4> rounds{};
+
+    void add(unsigned code) { rounds[code] += 1.0; }
+
+    double total() const { return rounds[0] + rounds[1] + rounds[2] + rounds[3]; }
+
+    OutcomeCounts& operator+=(const OutcomeCounts& other) {
+        for (int c = 0; c < 4; ++c) rounds[c] += other.rounds[c];
+        return *this;
+    }
+
+    OutcomeCounts operator-(const OutcomeCounts& other) const {
+        OutcomeCounts diff = *this;
+        for (int c = 0; c < 4; ++c) diff.rounds[c] -= other.rounds[c];
+        return diff;
+    }
+
+    OutcomeCounts operator*(double factor) const {
+        OutcomeCounts scaled = *this;
+        for (int c = 0; c < 4; ++c) scaled.rounds[c] *= factor;
+        return scaled;
+    }
+
+    // Payoff of each outcome code for player 1 and player 2
+    template<typename ScoreType>
+    static std::pair<std::array<ScoreType, 4>, std::array<ScoreType, 4>> payoffVectors(
+        const PayoffMatrix<ScoreType>& payoffs) {
+        std::array<ScoreType, 4> payoff1{}, payoff2{};
+        for (unsigned code = 0; code < 4; ++code) {
+            Move m1 = static_cast<Move>(code & 1u);
+            Move m2 = static_cast<Move>(code >> 1);
+            payoff1[code] = payoffs.getPayoff(m1, m2);
+            payoff2[code] = payoffs.getPayoff(m2, m1);
+        }
+        return { payoff1, payoff2 };
+    }
+
+    // Match scores of both players under the given payoffs
+    template<typename ScoreType>
+    std::pair<ScoreType, ScoreType> score(const PayoffMatrix<ScoreType>& payoffs) const {
+        auto [payoff1, payoff2] = payoffVectors(payoffs);
+        double score1 = 0.0, score2 = 0.0;
+        for (int c = 0; c < 4; ++c) {
+            score1 += rounds[c] * static_cast<double>(payoff1[c]);
+            score2 += rounds[c] * static_cast<double>(payoff2[c]);
+        }
+        return { static_cast<ScoreType>(score1), static_cast<ScoreType>(score2) };
+    }
+};
+
+#endif // OUTCOMECOUNTS_H
@@ -0,0 +1,198 @@
+﻿#ifndef OUTCOMETENSOR_H
+#define OUTCOMETENSOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "OutcomeCounts.h"
+
+/**
+ * @brief Outcome counts of a whole round-robin tournament, independent of the payoffs
+ *
+ * For every pairing (i, j) with i <= j, seen from player i, stores the number of games,
+ * the mean outcome counts and their 4x4 centered second moments (comoments). Since a
+ * game's score is a linear function w . counts of its counts, the mean of the scores
+ * under any payoff vector w is w . mean and their squared deviations sum to w' C w, so a
+ * tournament can be re-scored under any payoff matrix without re-simulating it. Games
+ * are added with Welford's update and cells merged with Chan's formula, so the spread is
+ * never formed as a difference of large sums.
+ *
+ * Only the upper triangles are stored: the pairings i <= j in one flat array, row by
+ * row, and the 10 distinct entries of each symmetric moment matrix. A cell is 120 bytes,
+ * so 10,000 strategies take 6 GB instead of the 17 GB of a full N x N x 4 x 4 table.
+ */
+class OutcomeTensor {
+public:
+    // Outcome code pairs (a, b), a <= b, of the packed moment entries
+    static constexpr int MOMENTS = 10;
+    static constexpr int MOMENT_A[MOMENTS] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 3 };
+    static constexpr int MOMENT_B[MOMENTS] = { 0, 1, 2, 3, 1, 2, 3, 2, 3, 3 };
+
+    struct Cell {
+        int games = 0;
+        OutcomeCounts mean;                      // mean counts over the games
+        std::array<double, MOMENTS> moments{};   // comoments: sum of (counts[a] - mean[a]) * (counts[b] - mean[b])
+
+        void add(const OutcomeCounts& counts) {
+            ++games;
+            OutcomeCounts before = counts - mean;
+            mean += before * (1.0 / games);
+            OutcomeCounts after = counts - mean;
+            for (int p = 0; p < MOMENTS; ++p)
+                moments[p] += before.rounds[MOMENT_A[p]] * after.rounds[MOMENT_B[p]];
+        }
+
+        void merge(const Cell& other) {
+            if (other.games == 0) return;
+            if (games == 0) {
+                *this = other;
+                return;
+            }
+            const double n1 = games, n2 = other.games, n = n1 + n2;
+            OutcomeCounts delta = other.mean - mean;
+            for (int p = 0; p < MOMENTS; ++p)
+                moments[p] += other.moments[p] + delta.rounds[MOMENT_A[p]] * delta.rounds[MOMENT_B[p]] * (n1 * n2 / n);
+            mean += delta * (n2 / n);
+            games += other.games;
+        }
+
+        // The same games seen from the other player: outcome codes 1 and 2 trade places
+        Cell swapped() const {
+            static constexpr int FLIP[4] = { 0, 2, 1, 3 };
+            Cell cell;
+            cell.games = games;
+            for (int a = 0; a < 4; ++a) cell.mean.rounds[FLIP[a]] = mean.rounds[a];
+            for (int p = 0; p < MOMENTS; ++p) {
+                const int a = std::min(FLIP[MOMENT_A[p]], FLIP[MOMENT_B[p]]);
+                const int b = std::max(FLIP[MOMENT_A[p]], FLIP[MOMENT_B[p]]);
+                cell.moments[4 * a - a * (a - 1) / 2 + (b - a)] = moments[p];
+            }
+            return cell;
+        }
+    };
+
+    // Running mean and sum of squared deviations of a set of game scores: enough for mean,
+    // variance and confidence interval. Scores are added one at a time with Welford's update
+    // and partial sets (per thread, per pairing) merged with Chan's formula, so no sample is
+    // kept and, like the cells they come from, totals never subtract n * mean^2 from a sum
+    // of squares.
+    struct ScoreMoments {
+        double games = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;   // sum of squared deviations from the mean
+
+        void add(double score) {
+            games += 1.0;
+            const double delta = score - mean;
+            mean += delta / games;
+            m2 += delta * (score - mean);
+        }
+
+        ScoreMoments& operator+=(const ScoreMoments& other) {
+            if (other.games == 0.0) return *this;
+            if (games == 0.0) return *this = other;
+            const double total = games + other.games;
+            const double delta = other.mean - mean;
+            mean += delta * (other.games / total);
+            m2 += other.m2 + delta * delta * (games * other.games / total);
+            games = total;
+            return *this;
+        }
+
+        double sum() const { return mean * games; }
+
+        // Sample variance (n - 1 in the denominator); 0 below two games
+        double variance() const { return games > 1.0 ? m2 / (games - 1.0) : 0.0; }
+
+        // The same mean and variance per game, counted as `weight` games
+        ScoreMoments reweighted(double weight) const {
+            if (games == 0.0) return *this;
+            return { weight, mean, games > 1.0 ? m2 * ((weight - 1.0) / (games - 1.0)) : 0.0 };
+        }
+    };
+
+private:
+    std::vector<std::string> names_;
+    std::vector<double> game_costs_; // SCB cost per game of each strategy (0 if disabled)
+    std::vector<Cell> cells_;        // pairings i <= j, row by row
+    int pairing_weight_ = 0;         // games every pairing counts as in strategy totals (0 = as played)
+    std::vector<std::vector<OutcomeCounts>> games_; // every game of each pairing, only if kept
+
+    // Position of pairing (i, j), i <= j: rows 0 .. i - 1 hold N + (N - 1) + ... cells
+    std::size_t index(int i, int j) const {
+        const std::size_t n = names_.size(), row = static_cast<std::size_t>(i);
+        return row * (2 * n - row + 1) / 2 + static_cast<std::size_t>(j - i);
+    }
+
+public:
+    OutcomeTensor() = default;
+    OutcomeTensor(std::vector<std::string> names, std::vector<double> game_costs)
+        : names_(std::move(names)), game_costs_(std::move(game_costs)),
+          cells_(names_.size() * (names_.size() + 1) / 2) {}
+
+    int size() const { return static_cast<int>(names_.size()); }
+    const std::string& name(int i) const { return names_[i]; }
+    double gameCost(int i) const { return game_costs_[i]; }
+
+    // Bytes of outcome data
+    std::size_t bytes() const {
+        std::size_t total = cells_.size() * sizeof(Cell);
+        for (const auto& games : games_) total += games.size() * sizeof(OutcomeCounts);
+        return total;
+    }
+
+    // Pairings played unequally often (adaptive repeats) still count equally in strategy
+    // totals when given a common weight
+    void setPairingWeight(int games) { pairing_weight_ = games; }
+    int pairingWeight() const { return pairing_weight_; }
+
+    // Add the games of a partial cell (e.g. one repeat block) to pairing (i, j), i <= j.
+    // Distinct pairings may be merged from different threads.
+    void merge(int i, int j, const Cell& games) {
+        cells_[index(i, j)].merge(games);
+    }
+
+    const Cell& cell(int i, int j) const {
+        return cells_[index(i, j)];
+    }
+
+    // Raw samples: also keep the counts of every game, in the order they were merged
+    void keepGames() { games_.resize(cells_.size()); }
+    bool keepsGames() const { return !games_.empty(); }
+
+    // Append games of pairing (i, j), i <= j, from strategy i's side; same threading rules as merge
+    void appendGames(int i, int j, const std::vector<OutcomeCounts>& games) {
+        auto& kept = games_[index(i, j)];
+        kept.insert(kept.end(), games.begin(), games.end());
+    }
+
+    const std::vector<OutcomeCounts>& games(int i, int j) const {
+        return games_[index(i, j)];
+    }
+
+    // Score sums of one side of a pairing: payoff[code] is that side's payoff for
+    // each outcome code of the cell (player i's view), cost its SCB cost per game
+    static ScoreMoments moments(const Cell& cell, const std::array<double, 4>& payoff, double cost) {
+        double linear = 0.0, quadratic = 0.0;
+        for (int a = 0; a < 4; ++a) {
+            linear += payoff[a] * cell.mean.rounds[a];
+        }
+        for (int p = 0; p < MOMENTS; ++p) {
+            const int a = MOMENT_A[p], b = MOMENT_B[p];
+            quadratic += (a == b ? 1.0 : 2.0) * payoff[a] * payoff[b] * cell.moments[p];
+        }
+        // The SCB cost shifts every score alike, so it moves the mean but not the spread.
+        // w' C w is a sum of squares; only rounding can take it below zero.
+        ScoreMoments m;
+        if (cell.games == 0) return m;
+        m.games = cell.games;
+        m.mean = linear - cost;
+        m.m2 = std::max(0.0, quadratic);
+        return m;
+    }
+};
+
+#endif // OUTCOMETENSOR_H
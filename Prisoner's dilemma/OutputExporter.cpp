@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <iostream>
+#include <cstdio>
 
 // ==================== Operator Overloading Implementations ====================
 
@@ -126,8 +127,9 @@ if (!file.is_open()) {
     return;
 }
     
-// Write header
-file << "Strategy,Mean,CI_Lower,CI_Upper,StdDev\n";
+// Write header; adaptive repeats give pairing-stratified CIs (see Simulator::scoreTournament)
+file << (hasStratifiedCI(results) ? "Strategy,Mean,Stratified_CI_Lower,Stratified_CI_Upper,StdDev\n"
+                                  : "Strategy,Mean,CI_Lower,CI_Upper,StdDev\n");
     
 // Sort by mean score (descending) - using overloaded > operator
 std::vector<std::pair<std::string, DoubleScoreStats>> sorted_results(results.begin(), results.end());
@@ -162,6 +164,7 @@ std::vector<std::pair<std::string, DoubleScoreStats>> sorted_results(results.beg
 std::sort(sorted_results.begin(), sorted_results.end(),
     [](const auto& a, const auto& b) { return a.second > b.second; });
     
+    const std::string ci = hasStratifiedCI(results) ? "stratified_ci" : "ci";
     file << "{\n";
     file << "  \"tournament_results\": [\n";
     
@@ -170,8 +173,8 @@ std::sort(sorted_results.begin(), sorted_results.end(),
         file << "    {\n";
         file << "      \"strategy\": \"" << escapeJson(name) << "\",\n";
         file << "      \"mean\": " << formatDouble(stats.mean, 4) << ",\n";
-        file << "      \"ci_lower\": " << formatDouble(stats.ci_lower, 4) << ",\n";
-        file << "      \"ci_upper\": " << formatDouble(stats.ci_upper, 4) << ",\n";
+        file << "      \"" << ci << "_lower\": " << formatDouble(stats.ci_lower, 4) << ",\n";
+        file << "      \"" << ci << "_upper\": " << formatDouble(stats.ci_upper, 4) << ",\n";
         file << "      \"stdev\": " << formatDouble(stats.stdev, 4) << "\n";
         file << "    }";
         if (i < sorted_results.size() - 1) file << ",";
@@ -201,7 +204,8 @@ std::sort(sorted_results.begin(), sorted_results.end(),
     [](const auto& a, const auto& b) { return a.second > b.second; });
     
     file << "# Tournament Results\n\n";
-    file << "| Rank | Strategy | Mean | 95% CI Lower | 95% CI Upper | Std Dev |\n";
+    const std::string ci = hasStratifiedCI(results) ? "Stratified 95% CI" : "95% CI";
+    file << "| Rank | Strategy | Mean | " << ci << " Lower | " << ci << " Upper | Std Dev |\n";
     file << "|------|----------|------|--------------|--------------|----------|\n";
     
     int rank = 1;
@@ -227,7 +231,10 @@ const std::string& filename) {
         return;
     }
     
-    file << "Epsilon,Strategy,Mean,StdDev,CI_Lower,CI_Upper\n";
+    const bool stratified = std::any_of(results.begin(), results.end(),
+        [](const auto& entry) { return hasStratifiedCI(entry.second); });
+    file << (stratified ? "Epsilon,Strategy,Mean,StdDev,Stratified_CI_Lower,Stratified_CI_Upper\n"
+                        : "Epsilon,Strategy,Mean,StdDev,CI_Lower,CI_Upper\n");
     
     for (const auto& [epsilon, strategy_results] : results) {
         for (const auto& [strategy, stats] : strategy_results) {
@@ -254,6 +261,10 @@ const std::string& filename) {
         return;
     }
     
+    const bool stratified = std::any_of(results.begin(), results.end(),
+        [](const auto& entry) { return hasStratifiedCI(entry.second); });
+    const std::string ci = stratified ? "stratified_ci" : "ci";
+
     file << "{\n";
     file << "  \"noise_sweep_results\": [\n";
     
@@ -269,8 +280,8 @@ const std::string& filename) {
             file << "          \"name\": \"" << escapeJson(strategy) << "\",\n";
             file << "          \"mean\": " << formatDouble(stats.mean, 4) << ",\n";
             file << "          \"stdev\": " << formatDouble(stats.stdev, 4) << ",\n";
-            file << "          \"ci_lower\": " << formatDouble(stats.ci_lower, 4) << ",\n";
-            file << "          \"ci_upper\": " << formatDouble(stats.ci_upper, 4) << "\n";
+            file << "          \"" << ci << "_lower\": " << formatDouble(stats.ci_lower, 4) << ",\n";
+            file << "          \"" << ci << "_upper\": " << formatDouble(stats.ci_upper, 4) << "\n";
             file << "        }";
             if (strat_idx < strategy_results.size() - 1) file << ",";
             file << "\n";
@@ -291,6 +302,133 @@ const std::string& filename) {
     std::cout << "Noise sweep results exported to: " << filename << "\n";
 }
 
+void OutputExporter::exportPayoffGridCSV(
+const std::vector<PayoffGridPoint<double>>& grid,
+const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+    
+    const bool stratified = std::any_of(grid.begin(), grid.end(),
+        [](const auto& point) { return hasStratifiedCI(point.stats); });
+    file << (stratified ? "T,R,P,S,Strategy,Mean,StdDev,Stratified_CI_Lower,Stratified_CI_Upper\n"
+                        : "T,R,P,S,Strategy,Mean,StdDev,CI_Lower,CI_Upper\n");
+    
+    for (const auto& point : grid) {
+        for (const auto& [strategy, stats] : point.stats) {
+            file << formatDouble(point.payoffs.getTemptation()) << ","
+                 << formatDouble(point.payoffs.getReward()) << ","
+                 << formatDouble(point.payoffs.getPunishment()) << ","
+                 << formatDouble(point.payoffs.getSucker()) << ","
+                 << escapeCsv(strategy) << ","
+                 << formatDouble(stats.mean) << ","
+                 << formatDouble(stats.stdev) << ","
+                 << formatDouble(stats.ci_lower) << ","
+                 << formatDouble(stats.ci_upper) << "\n";
+        }
+    }
+    
+    file.close();
+    std::cout << "Payoff grid results exported to: " << filename << "\n";
+}
+
+void OutputExporter::exportPayoffGridJSON(
+const std::vector<PayoffGridPoint<double>>& grid,
+const std::string& filename) {
+    
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+    
+    const bool stratified = std::any_of(grid.begin(), grid.end(),
+        [](const auto& point) { return hasStratifiedCI(point.stats); });
+    const std::string ci = stratified ? "stratified_ci" : "ci";
+
+    file << "{\n";
+    file << "  \"payoff_grid_results\": [\n";
+    
+    for (size_t p = 0; p < grid.size(); ++p) {
+        const auto& point = grid[p];
+        file << "    {\n";
+        file << "      \"T\": " << formatDouble(point.payoffs.getTemptation(), 4) << ",\n";
+        file << "      \"R\": " << formatDouble(point.payoffs.getReward(), 4) << ",\n";
+        file << "      \"P\": " << formatDouble(point.payoffs.getPunishment(), 4) << ",\n";
+        file << "      \"S\": " << formatDouble(point.payoffs.getSucker(), 4) << ",\n";
+        file << "      \"strategies\": [\n";
+        
+        size_t strat_idx = 0;
+        for (const auto& [strategy, stats] : point.stats) {
+            file << "        {\n";
+            file << "          \"name\": \"" << escapeJson(strategy) << "\",\n";
+            file << "          \"mean\": " << formatDouble(stats.mean, 4) << ",\n";
+            file << "          \"stdev\": " << formatDouble(stats.stdev, 4) << ",\n";
+            file << "          \"" << ci << "_lower\": " << formatDouble(stats.ci_lower, 4) << ",\n";
+            file << "          \"" << ci << "_upper\": " << formatDouble(stats.ci_upper, 4) << "\n";
+            file << "        }";
+            if (strat_idx < point.stats.size() - 1) file << ",";
+            file << "\n";
+            ++strat_idx;
+        }
+        
+        file << "      ]\n";
+        file << "    }";
+        if (p < grid.size() - 1) file << ",";
+        file << "\n";
+    }
+    
+    file << "  ]\n";
+    file << "}\n";
+    
+    file.close();
+    std::cout << "Payoff grid results exported to: " << filename << "\n";
+}
+
+OutputExporter::MatchMatrixWriter::MatchMatrixWriter(
+    const std::string& filename,
+    const std::vector<std::unique_ptr<Strategy>>& strategies)
+    : file_(filename), filename_(filename), columns_(strategies.size()) {
+
+    if (!file_.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+
+    file_ << "Strategy";
+    for (const auto& s : strategies) {
+        file_ << "," << escapeCsv(s->getName());
+    }
+    file_ << "\n";
+}
+
+void OutputExporter::MatchMatrixWriter::writeRow(
+    const std::string& name,
+    const std::vector<std::pair<double, double>>& scores) {
+
+    if (!file_.is_open()) return;
+
+    // snprintf into one buffer per row: far cheaper than stream formatting of N^2 values
+    line_ = escapeCsv(name);
+    char value[32];
+    for (const auto& score : scores) {
+        int length = std::snprintf(value, sizeof(value), ",%.4f", score.first);
+        line_.append(value, static_cast<std::size_t>(length));
+    }
+    line_ += '\n';
+    file_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    ++rows_;
+}
+
+void OutputExporter::MatchMatrixWriter::close() {
+    if (!file_.is_open()) return;
+    file_.close();
+    std::cout << "Match matrix (" << rows_ << " x " << columns_ << ") exported to: " << filename_ << "\n";
+}
+
 void OutputExporter::exportEvolutionCSV(
     const std::vector<std::map<std::string, double>>& history,
     const std::vector<std::unique_ptr<Strategy>>& strategies,
@@ -365,3 +503,130 @@ void OutputExporter::exportEvolutionJSON(
     file.close();
     std::cout << "Evolution history (" << label << ") exported to: " << filename << "\n";
 }
+
+void OutputExporter::exportOptimizationCSV(
+    const std::vector<OptimizationStep>& steps,
+    const std::string& filename) {
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+
+    file << "Generation,Best Fitness,Mean Fitness,Scored,Best Strategy\n";
+    for (const auto& step : steps) {
+        file << step.generation << ","
+             << formatDouble(step.best_fitness, 4) << ","
+             << formatDouble(step.mean_fitness, 4) << ","
+             << step.scored << ","
+             << escapeCsv(step.best) << "\n";
+    }
+
+    file.close();
+    std::cout << "Genetic search history exported to: " << filename << "\n";
+}
+
+void OutputExporter::exportOptimizationJSON(
+    const std::vector<OptimizationStep>& steps,
+    const std::string& filename) {
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+
+    file << "{\n";
+    file << "  \"optimization_history\": [\n";
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const auto& step = steps[i];
+        file << "    {\n";
+        file << "      \"generation\": " << step.generation << ",\n";
+        file << "      \"best_fitness\": " << formatDouble(step.best_fitness, 4) << ",\n";
+        file << "      \"mean_fitness\": " << formatDouble(step.mean_fitness, 4) << ",\n";
+        file << "      \"scored\": " << step.scored << ",\n";
+        file << "      \"best_strategy\": \"" << escapeJson(step.best) << "\"\n";
+        file << "    }";
+        if (i < steps.size() - 1) file << ",";
+        file << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+
+    file.close();
+    std::cout << "Genetic search history exported to: " << filename << "\n";
+}
+
+void OutputExporter::exportSamplesCSV(
+    const std::map<std::string, std::vector<double>>& samples,
+    const std::string& filename) {
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+
+    file << "Strategy,Game,Score\n";
+    std::size_t rows = 0;
+    std::string line;
+    char value[48];
+    for (const auto& [name, scores] : samples) {
+        const std::string strategy = escapeCsv(name);
+        for (std::size_t g = 0; g < scores.size(); ++g) {
+            int length = std::snprintf(value, sizeof(value), ",%zu,%.4f\n", g + 1, scores[g]);
+            line = strategy;
+            line.append(value, static_cast<std::size_t>(length));
+            file.write(line.data(), static_cast<std::streamsize>(line.size()));
+        }
+        rows += scores.size();
+    }
+
+    file.close();
+    std::cout << "Raw game scores (" << rows << " samples) exported to: " << filename << "\n";
+}
+
+void OutputExporter::exportLatticeSnapshot(
+    const std::vector<std::uint16_t>& cells,
+    int width,
+    int height,
+    int generation,
+    const std::vector<std::unique_ptr<Strategy>>& strategies,
+    const std::string& filename) {
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing.\n";
+        return;
+    }
+
+    // All integers little-endian, independent of the host
+    std::vector<char> bytes;
+    auto put32 = [&bytes](std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) bytes.push_back(static_cast<char>(value >> shift));
+    };
+
+    bytes.insert(bytes.end(), { 'P', 'D', 'L', 'A', 'T', 'T', 'C', '1' });
+    put32(static_cast<std::uint32_t>(width));
+    put32(static_cast<std::uint32_t>(height));
+    put32(static_cast<std::uint32_t>(generation));
+    put32(static_cast<std::uint32_t>(strategies.size()));
+    for (const auto& s : strategies) {
+        const std::string& name = s->getName();
+        put32(static_cast<std::uint32_t>(name.size()));
+        bytes.insert(bytes.end(), name.begin(), name.end());
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    // Cells row by row
+    std::vector<char> row(2 * static_cast<std::size_t>(width));
+    for (int y = 0; y < height; ++y) {
+        const std::uint16_t* source = &cells[static_cast<std::size_t>(y) * width];
+        for (int x = 0; x < width; ++x) {
+            row[2 * x] = static_cast<char>(source[x] & 0xFF);
+            row[2 * x + 1] = static_cast<char>(source[x] >> 8);
+        }
+        file.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+}
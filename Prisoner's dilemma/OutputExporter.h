@@ -1,6 +1,8 @@
 ﻿#ifndef OUTPUTEXPORTER_H
 #define OUTPUTEXPORTER_H
 
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <map>
 #include <vector>
@@ -8,6 +10,7 @@
 #include <iostream>
 #include "Strategy.h"
 #include "Simulator.h"
+#include "GeneticOptimizer.h"
 
 // Forward declarations for operator overloading
 std::ostream& operator<<(std::ostream& os, Move move);
@@ -52,6 +55,29 @@ struct LeaderboardEntry {
  */
 class OutputExporter {
 public:
+    /**
+     * @brief Writes a tournament's pairwise score matrix to CSV one row at a time
+     *
+     * Row i, column j is the average score of strategy i against strategy j. Rows are
+     * written as they are produced, so the N x N table is never held in memory.
+     */
+    class MatchMatrixWriter {
+    public:
+        MatchMatrixWriter(const std::string& filename, const std::vector<std::unique_ptr<Strategy>>& strategies);
+
+        void writeRow(const std::string& name, const std::vector<std::pair<double, double>>& scores);
+
+        // Finish the file and report it
+        void close();
+
+    private:
+        std::ofstream file_;
+        std::string filename_;
+        std::string line_;  // reused for every row
+        std::size_t rows_ = 0;
+        std::size_t columns_ = 0;
+    };
+
 // Export tournament results to CSV
 static void exportTournamentCSV(
     const std::map<std::string, DoubleScoreStats>& results,
@@ -77,6 +103,16 @@ static void exportNoiseSweepJSON(
     const std::map<double, std::map<std::string, DoubleScoreStats>>& results,
     const std::string& filename);
     
+// Export payoff grid results to CSV
+static void exportPayoffGridCSV(
+    const std::vector<PayoffGridPoint<double>>& grid,
+    const std::string& filename);
+
+// Export payoff grid results to JSON
+static void exportPayoffGridJSON(
+    const std::vector<PayoffGridPoint<double>>& grid,
+    const std::string& filename);
+    
     // Export evolution history to CSV
     static void exportEvolutionCSV(
         const std::vector<std::map<std::string, double>>& history,
@@ -90,6 +126,33 @@ static void exportNoiseSweepJSON(
         const std::vector<std::unique_ptr<Strategy>>& strategies,
         const std::string& label,
         const std::string& filename);
+
+    // Export the fittest genome and the best and mean fitness of every generation of a genetic search to CSV
+    static void exportOptimizationCSV(
+        const std::vector<OptimizationStep>& steps,
+        const std::string& filename);
+
+    // Export the same history to JSON
+    static void exportOptimizationJSON(
+        const std::vector<OptimizationStep>& steps,
+        const std::string& filename);
+
+    // Export every game score of a tournament (Simulator::gameScores) to CSV, one row per game
+    static void exportSamplesCSV(
+        const std::map<std::string, std::vector<double>>& samples,
+        const std::string& filename);
+
+    // Export a binary snapshot of a spatial lattice: the header "PDLATTC1", then width,
+    // height, generation and strategy count as little-endian uint32, each strategy name
+    // as a uint32 length and its bytes, then one little-endian uint16 strategy index per
+    // cell, row by row
+    static void exportLatticeSnapshot(
+        const std::vector<std::uint16_t>& cells,
+        int width,
+        int height,
+        int generation,
+        const std::vector<std::unique_ptr<Strategy>>& strategies,
+        const std::string& filename);
     
 private:
     // Helper to format double values
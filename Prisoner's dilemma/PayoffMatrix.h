@@ -53,20 +53,11 @@ public:
     }
     
     // Get payoff for a specific outcome
+    // Indexed by (my move | opponent's move << 1): CC -> R, DC -> T, CD -> S, DD -> P
     ScoreType getPayoff(Move myMove, Move oppMove) const {
-        if (myMove == Move::Defect && oppMove == Move::Cooperate) {
-            return payoffs_[0];  // T (Temptation)
-        }
-        if (myMove == Move::Cooperate && oppMove == Move::Cooperate) {
-            return payoffs_[1];  // R (Reward)
-        }
-        if (myMove == Move::Defect && oppMove == Move::Defect) {
-            return payoffs_[2];  // P (Punishment)
-        }
-        if (myMove == Move::Cooperate && oppMove == Move::Defect) {
-            return payoffs_[3];  // S (Sucker)
-        }
-        return ScoreType(0);
+        static constexpr unsigned char outcome_to_payoff[4] = { 1, 0, 3, 2 };
+        unsigned outcome = static_cast<unsigned>(myMove) | (static_cast<unsigned>(oppMove) << 1);
+        return payoffs_[outcome_to_payoff[outcome]];
     }
     
     // Getters for individual payoffs
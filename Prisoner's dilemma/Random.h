@@ -0,0 +1,120 @@
+﻿#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/**
+ * @brief Seed-mixing helpers and samplers shared by the match engines
+ */
+
+// SplitMix64 finalizer: turns nearby inputs into unrelated 64-bit seeds
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Stable 64-bit FNV-1a hash (std::hash is not portable across compilers)
+inline std::uint64_t fnv1a(const std::string& text) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Derive a child seed from a parent seed and a stream identifier
+inline std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream) {
+    return splitmix64(seed ^ splitmix64(stream));
+}
+
+// Uniform double in (0, 1] from a 64-bit generator
+template<typename Engine>
+inline double uniformOpenClosed(Engine& engine) {
+    std::uint64_t bits = static_cast<std::uint64_t>(engine()) >> 11;
+    return (bits + 1) * (1.0 / 9007199254740992.0); // 2^53
+}
+
+// Uniform double in [0, 1) from a 64-bit generator
+template<typename Engine>
+inline double uniformClosedOpen(Engine& engine) {
+    return (static_cast<std::uint64_t>(engine()) >> 11) * (1.0 / 9007199254740992.0); // 2^53
+}
+
+// Uniform index in [0, n) from a 64-bit generator
+template<typename Engine>
+inline std::size_t uniformIndex(Engine& engine, std::size_t n) {
+    std::size_t index = static_cast<std::size_t>(uniformClosedOpen(engine) * static_cast<double>(n));
+    return index < n ? index : n - 1;
+}
+
+/**
+ * @brief Positions of Bernoulli(p) successes in an endless bit stream
+ *
+ * Instead of one uniform draw per bit, draws the geometric gap to the next
+ * success, so the cost scales with the number of successes. Bits can be read
+ * one at a time (next) or 64 at a time (fill). Engines must return 64 random bits.
+ */
+class GeometricFlipSampler {
+private:
+    double log_q_ = 0.0;        // log(1 - p)
+    std::uint64_t next_ = 0;    // offset of the next success from the current position
+    bool always_ = false;
+    bool never_ = true;
+
+public:
+    GeometricFlipSampler() = default;
+
+    template<typename Engine>
+    GeometricFlipSampler(double p, Engine& engine) {
+        never_ = p <= 0.0;
+        always_ = p >= 1.0;
+        if (!never_ && !always_) {
+            log_q_ = std::log1p(-p);
+            next_ = gap(engine);
+        }
+    }
+
+    // Number of failures before the next success
+    template<typename Engine>
+    std::uint64_t gap(Engine& engine) const {
+        double g = std::floor(std::log(uniformOpenClosed(engine)) / log_q_);
+        const double cap = static_cast<double>(std::numeric_limits<std::uint64_t>::max() / 4);
+        return g < cap ? static_cast<std::uint64_t>(g) : static_cast<std::uint64_t>(cap);
+    }
+
+    // Read the next bit of the stream
+    template<typename Engine>
+    bool next(Engine& engine) {
+        if (never_ || always_) return always_;
+        if (next_ > 0) {
+            --next_;
+            return false;
+        }
+        next_ = gap(engine);
+        return true;
+    }
+
+    // Fill `words` 64-bit masks with the next 64 * words bits of the stream
+    template<typename Engine>
+    void fill(std::uint64_t* masks, int words, Engine& engine) {
+        const std::uint64_t bits = static_cast<std::uint64_t>(words) * 64;
+        for (int w = 0; w < words; ++w) {
+            masks[w] = always_ ? ~std::uint64_t(0) : 0;
+        }
+        if (never_ || always_) return;
+        while (next_ < bits) {
+            masks[next_ / 64] |= std::uint64_t(1) << (next_ % 64);
+            next_ += 1 + gap(engine);
+        }
+        next_ -= bits;
+    }
+};
+
+#endif // RANDOM_H
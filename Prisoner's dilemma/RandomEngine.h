@@ -0,0 +1,221 @@
+﻿#ifndef RANDOMENGINE_H
+#define RANDOMENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "Random.h"
+
+/**
+ * @brief Random number engines for match states and the bit-sliced engine
+ *
+ * MT19937 (std::mt19937, as in the original strategies) is the compatibility
+ * default; two 32-bit outputs make one 64-bit draw. Its 2.5 KB of state lives
+ * on the heap, so the compact engines below keep a StrategyState small:
+ *   XOSHIRO256PP - xoshiro256++, 32 bytes
+ *   PCG32        - PCG-XSH-RR 64/32, 16 bytes, two outputs per 64-bit draw
+ *   PHILOX       - Philox4x32-10, counter-based, 44 bytes
+ */
+enum class RngKind {
+    MT19937,
+    XOSHIRO256PP,
+    PCG32,
+    PHILOX
+};
+
+inline std::string rngKindName(RngKind kind) {
+    switch (kind) {
+    case RngKind::XOSHIRO256PP: return "xoshiro256pp";
+    case RngKind::PCG32: return "pcg32";
+    case RngKind::PHILOX: return "philox";
+    default: return "mt19937";
+    }
+}
+
+inline RngKind parseRngKind(const std::string& name) {
+    if (name == "mt19937") return RngKind::MT19937;
+    if (name == "xoshiro256pp") return RngKind::XOSHIRO256PP;
+    if (name == "pcg32") return RngKind::PCG32;
+    if (name == "philox") return RngKind::PHILOX;
+    throw std::invalid_argument("Unknown RNG engine: " + name);
+}
+
+// xoshiro256++ (Blackman & Vigna); seeded from a SplitMix64 sequence
+struct Xoshiro256pp {
+    std::uint64_t s[4];
+
+    void seed(std::uint64_t value) {
+        for (int i = 0; i < 4; ++i) {
+            s[i] = splitmix64(value + static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull);
+        }
+    }
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t operator()() {
+        const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+};
+
+// PCG-XSH-RR with 64-bit state and 32-bit output (O'Neill); the stream is derived from the seed
+struct Pcg32 {
+    std::uint64_t state;
+    std::uint64_t inc;
+
+    void seed(std::uint64_t value) {
+        state = 0;
+        inc = (splitmix64(value) << 1) | 1u;
+        (*this)();
+        state += value;
+        (*this)();
+    }
+
+    std::uint32_t operator()() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+};
+
+// Philox4x32-10 (Salmon et al.): output block n is a keyed bijection of the counter n
+struct Philox4x32 {
+    std::uint32_t counter[4];
+    std::uint32_t key[2];
+    std::uint32_t block[4];
+    int used; // 64-bit halves of `block` already returned
+
+    void seed(std::uint64_t value) {
+        key[0] = static_cast<std::uint32_t>(value);
+        key[1] = static_cast<std::uint32_t>(value >> 32);
+        counter[0] = counter[1] = counter[2] = counter[3] = 0;
+        used = 2;
+    }
+
+    void generate() {
+        std::uint32_t c[4] = { counter[0], counter[1], counter[2], counter[3] };
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            std::uint64_t p0 = 0xD2511F53ull * c[0];
+            std::uint64_t p1 = 0xCD9E8D57ull * c[2];
+            std::uint32_t next[4] = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<std::uint32_t>(p0)
+            };
+            c[0] = next[0]; c[1] = next[1]; c[2] = next[2]; c[3] = next[3];
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        block[0] = c[0]; block[1] = c[1]; block[2] = c[2]; block[3] = c[3];
+        for (int i = 0; i < 4; ++i) { // 128-bit increment
+            if (++counter[i] != 0) break;
+        }
+        used = 0;
+    }
+
+    std::uint64_t operator()() {
+        if (used == 2) generate();
+        std::uint64_t result = (static_cast<std::uint64_t>(block[2 * used + 1]) << 32) | block[2 * used];
+        ++used;
+        return result;
+    }
+};
+
+/**
+ * @brief 64-bit engine of a kind chosen at run time
+ *
+ * Satisfies UniformRandomBitGenerator, so it works with the standard distributions
+ * and the samplers in Random.h. Copies are independent engines with the same state.
+ */
+class RandomEngine {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    union Compact {
+        Xoshiro256pp xoshiro;
+        Pcg32 pcg;
+        Philox4x32 philox;
+    };
+
+    RngKind kind_;
+    Compact compact_{};
+    std::unique_ptr<std::mt19937> mt_; // MT19937 only
+
+public:
+    explicit RandomEngine(std::uint64_t seed = std::mt19937::default_seed, RngKind kind = RngKind::MT19937)
+        : kind_(kind) {
+        switch (kind_) {
+        case RngKind::XOSHIRO256PP: compact_.xoshiro.seed(seed); break;
+        case RngKind::PCG32: compact_.pcg.seed(seed); break;
+        case RngKind::PHILOX: compact_.philox.seed(seed); break;
+        default: mt_ = std::make_unique<std::mt19937>(static_cast<std::uint32_t>(seed ^ (seed >> 32))); break;
+        }
+    }
+
+    RandomEngine(const RandomEngine& other)
+        : kind_(other.kind_), compact_(other.compact_),
+          mt_(other.mt_ ? std::make_unique<std::mt19937>(*other.mt_) : nullptr) {
+    }
+
+    RandomEngine& operator=(const RandomEngine& other) {
+        if (this != &other) {
+            kind_ = other.kind_;
+            compact_ = other.compact_;
+            mt_ = other.mt_ ? std::make_unique<std::mt19937>(*other.mt_) : nullptr;
+        }
+        return *this;
+    }
+
+    RandomEngine(RandomEngine&&) = default;
+    RandomEngine& operator=(RandomEngine&&) = default;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()() {
+        switch (kind_) {
+        case RngKind::XOSHIRO256PP: return compact_.xoshiro();
+        case RngKind::PCG32: {
+            std::uint64_t high = compact_.pcg();
+            return (high << 32) | compact_.pcg();
+        }
+        case RngKind::PHILOX: return compact_.philox();
+        default: {
+            std::uint64_t high = (*mt_)();
+            return (high << 32) | (*mt_)();
+        }
+        }
+    }
+
+    RngKind kind() const { return kind_; }
+
+    // Bytes of engine state kept outside the object (the MT19937 state)
+    std::size_t heapBytes() const { return mt_ ? sizeof(std::mt19937) : 0; }
+
+    // Bytes of state of the selected engine itself
+    std::size_t stateBytes() const {
+        switch (kind_) {
+        case RngKind::XOSHIRO256PP: return sizeof(Xoshiro256pp);
+        case RngKind::PCG32: return sizeof(Pcg32);
+        case RngKind::PHILOX: return sizeof(Philox4x32);
+        default: return sizeof(std::mt19937);
+        }
+    }
+};
+
+#endif // RANDOMENGINE_H
@@ -0,0 +1,328 @@
+﻿#ifndef REPLICATORSOLVER_H
+#define REPLICATORSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+
+/**
+ * @brief How the replicator dynamics are advanced from one generation to the next
+ *   DISCRETE - the discrete replicator map x_i' = x_i * f_i / avg (one step per generation)
+ *   RK45     - the continuous replicator equation dx_i/dt = x_i * (f_i - avg), integrated
+ *              over one unit of time per generation with adaptive Dormand-Prince steps
+ */
+enum class ReplicatorMethod {
+    DISCRETE,
+    RK45
+};
+
+inline std::string replicatorMethodName(ReplicatorMethod method) {
+    return method == ReplicatorMethod::RK45 ? "rk45" : "discrete";
+}
+
+inline ReplicatorMethod parseReplicatorMethod(const std::string& name) {
+    if (name == "discrete") return ReplicatorMethod::DISCRETE;
+    if (name == "rk45") return ReplicatorMethod::RK45;
+    throw std::invalid_argument("Unknown replicator method: " + name);
+}
+
+/**
+ * @brief Replicator dynamics over dense population shares and a fixed payoff matrix
+ *
+ * payoffs[i][j] is the average score of strategy i against strategy j; the fitness of
+ * strategy i is row i times the shares. Strategies whose share falls below the
+ * extinction threshold are no longer met and die out, so the solver only works on the
+ * surviving strategies: their rows and columns are packed into a contiguous square
+ * matrix. Extinct strategies stay in it with share 0 until a quarter of it is extinct,
+ * then it is packed again, so repacking costs O(1) amortized per strategy. The product is written with four
+ * independent accumulators per row, which the compiler turns into vector instructions
+ * without reordering the sums; large matrices are split into row blocks over a pool.
+ *
+ * The run stops early once a generation repeats one of the last max_period generations
+ * within the tolerance: a fixed point (period 1) or, for the discrete map, a cycle.
+ */
+class ReplicatorSolver {
+public:
+    struct Options {
+        ReplicatorMethod method = ReplicatorMethod::DISCRETE;
+        double tolerance = 1e-10;    // largest share change that still counts as a repeat (0 = never stop early)
+        int max_period = 32;         // longest cycle looked for
+        double extinction = 1e-6;    // shares below this are extinct
+        double rk_tolerance = 1e-8;  // local error tolerance of the RK45 steps
+        int record_every = 1;        // keep every n-th generation in the trajectory (0 = first and last only)
+        ThreadPool* pool = nullptr;  // optional pool for the product of large matrices
+    };
+
+    struct Result {
+        std::vector<std::vector<double>> trajectory; // shares of the recorded generations
+        std::vector<int> generations;                // generation number of each recorded entry
+        int converged_at = -1;       // generation at which a repeat was detected, -1 if none
+        int period = 0;              // 1 = fixed point, > 1 = cycle length
+        long long steps = 0;         // discrete updates or accepted RK45 steps
+        bool stalled = false;        // discrete map: average fitness too low, update skipped
+    };
+
+private:
+    static constexpr std::size_t PARALLEL_ROWS = 512; // smallest matrix worth splitting over threads
+    static constexpr std::size_t ROW_BLOCK = 64;
+
+    std::size_t n_;
+    std::vector<double> payoffs_; // n x n, row-major
+    Options options_;
+
+    // Surviving strategies and their packed payoff matrix
+    struct Active {
+        std::vector<std::size_t> index;
+        std::vector<double> matrix;
+
+        std::size_t size() const { return index.size(); }
+    };
+
+    void pack(const std::vector<double>& shares, Active& active) const {
+        active.index.clear();
+        for (std::size_t i = 0; i < n_; ++i) {
+            if (shares[i] >= options_.extinction) active.index.push_back(i);
+        }
+        const std::size_t m = active.size();
+        active.matrix.resize(m * m);
+        for (std::size_t a = 0; a < m; ++a) {
+            const double* row = &payoffs_[active.index[a] * n_];
+            for (std::size_t b = 0; b < m; ++b) {
+                active.matrix[a * m + b] = row[active.index[b]];
+            }
+        }
+    }
+
+    static double dot(const double* row, const double* x, std::size_t m) {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        std::size_t j = 0;
+        for (; j + 4 <= m; j += 4) {
+            s0 += row[j] * x[j];
+            s1 += row[j + 1] * x[j + 1];
+            s2 += row[j + 2] * x[j + 2];
+            s3 += row[j + 3] * x[j + 3];
+        }
+        for (; j < m; ++j) s0 += row[j] * x[j];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    // fitness = matrix * x over the packed strategies
+    void multiply(const Active& active, const std::vector<double>& x, std::vector<double>& fitness) const {
+        const std::size_t m = active.size();
+        fitness.resize(m);
+        auto rows = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t a = begin; a < end; ++a) {
+                fitness[a] = dot(&active.matrix[a * m], x.data(), m);
+            }
+        };
+        if (options_.pool && options_.pool->size() > 1 && m >= PARALLEL_ROWS) {
+            options_.pool->parallelFor((m + ROW_BLOCK - 1) / ROW_BLOCK, [&](std::size_t block) {
+                rows(block * ROW_BLOCK, std::min(m, (block + 1) * ROW_BLOCK));
+            });
+        }
+        else {
+            rows(0, m);
+        }
+    }
+
+    // Replicator field dx/dt = x * (f - avg) of the packed shares
+    void field(const Active& active, const std::vector<double>& x, std::vector<double>& fitness,
+               std::vector<double>& dx) const {
+        multiply(active, x, fitness);
+        double avg = 0.0;
+        for (std::size_t a = 0; a < x.size(); ++a) avg += fitness[a] * x[a];
+        dx.resize(x.size());
+        for (std::size_t a = 0; a < x.size(); ++a) dx[a] = x[a] * (fitness[a] - avg);
+    }
+
+    // Packed shares; extinct strategies count as 0
+    void gather(const Active& active, const std::vector<double>& shares, std::vector<double>& x) const {
+        x.resize(active.size());
+        for (std::size_t a = 0; a < active.size(); ++a) {
+            double share = shares[active.index[a]];
+            x[a] = share < options_.extinction ? 0.0 : share;
+        }
+    }
+
+    static void scatter(const Active& active, const std::vector<double>& x, std::vector<double>& shares) {
+        std::fill(shares.begin(), shares.end(), 0.0);
+        for (std::size_t a = 0; a < active.size(); ++a) shares[active.index[a]] = x[a];
+    }
+
+    // One generation of the discrete map. Extinct strategies have fitness 0 and drop to 0.
+    // Returns false (shares unchanged) if the average fitness is too low to divide by.
+    bool discreteStep(const Active& active, std::vector<double>& shares, std::vector<double>& x,
+                      std::vector<double>& fitness) const {
+        gather(active, shares, x);
+        multiply(active, x, fitness);
+        double avg = 0.0;
+        for (std::size_t a = 0; a < x.size(); ++a) avg += fitness[a] * x[a];
+        if (avg < 1e-9) return false;
+        for (std::size_t a = 0; a < x.size(); ++a) x[a] *= fitness[a] / avg;
+        scatter(active, x, shares);
+        return true;
+    }
+
+    // Work vectors of the RK45 integrator; the step size carries over between generations
+    struct RungeKutta {
+        std::vector<double> k[7];
+        std::vector<double> x, stage, next, fitness;
+        double h = 0.1;
+    };
+
+    // One unit of time of the continuous equation with Dormand-Prince 5(4) steps.
+    // Extinct shares are set to 0 and the rest renormalized at the end of the generation,
+    // so the field is evaluated afresh at the start of each one.
+    long long continuousStep(const Active& active, std::vector<double>& shares, RungeKutta& rk) const {
+        static const double c[7][6] = {
+            {},
+            { 1.0 / 5 },
+            { 3.0 / 40, 9.0 / 40 },
+            { 44.0 / 45, -56.0 / 15, 32.0 / 9 },
+            { 19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729 },
+            { 9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176, -5103.0 / 18656 },
+            { 35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84 }
+        };
+        // Fifth-order minus embedded fourth-order weights
+        static const double e[7] = { 71.0 / 57600, 0.0, -71.0 / 16695, 71.0 / 1920,
+                                     -17253.0 / 339200, 22.0 / 525, -1.0 / 40 };
+
+        const std::size_t m = active.size();
+        gather(active, shares, rk.x);
+        field(active, rk.x, rk.fitness, rk.k[0]);
+
+        long long accepted = 0;
+        double t = 0.0;
+        while (t < 1.0) {
+            const double h = std::min(rk.h, 1.0 - t);
+            for (int s = 1; s < 7; ++s) {
+                rk.stage.resize(m);
+                for (std::size_t a = 0; a < m; ++a) {
+                    double sum = 0.0;
+                    for (int r = 0; r < s; ++r) sum += c[s][r] * rk.k[r][a];
+                    rk.stage[a] = rk.x[a] + h * sum;
+                }
+                field(active, rk.stage, rk.fitness, rk.k[s]);
+            }
+            // Stage 7 is evaluated at the fifth-order solution
+            rk.next = rk.stage;
+
+            double error = 0.0;
+            for (std::size_t a = 0; a < m; ++a) {
+                double local = 0.0;
+                for (int s = 0; s < 7; ++s) local += e[s] * rk.k[s][a];
+                double scale = options_.rk_tolerance * (1.0 + std::max(std::abs(rk.x[a]), std::abs(rk.next[a])));
+                error = std::max(error, std::abs(h * local) / scale);
+            }
+
+            if (error <= 1.0) {
+                t += h;
+                rk.x.swap(rk.next);
+                std::swap(rk.k[0], rk.k[6]);
+                ++accepted;
+            }
+            // Only grow or shrink the step when it was not cut short by the generation end
+            if (error > 1.0 || h == rk.h) {
+                double factor = error > 0.0 ? 0.9 * std::pow(error, -0.2) : 5.0;
+                rk.h = h * std::min(5.0, std::max(0.2, factor));
+            }
+        }
+
+        double total = 0.0;
+        for (std::size_t a = 0; a < m; ++a) {
+            if (rk.x[a] < options_.extinction) rk.x[a] = 0.0;
+            total += rk.x[a];
+        }
+        if (total > 0.0) {
+            for (std::size_t a = 0; a < m; ++a) rk.x[a] /= total;
+        }
+        scatter(active, rk.x, shares);
+        return accepted;
+    }
+
+    static bool sameShares(const std::vector<double>& a, const std::vector<double>& b, double tolerance) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::abs(a[i] - b[i]) > tolerance) return false;
+        }
+        return true;
+    }
+
+public:
+    ReplicatorSolver(const std::vector<std::vector<double>>& payoffs, const Options& options)
+        : n_(payoffs.size()), payoffs_(n_ * n_), options_(options) {
+        for (std::size_t i = 0; i < n_; ++i) {
+            if (payoffs[i].size() != n_) throw std::invalid_argument("Payoff matrix must be square");
+            std::copy(payoffs[i].begin(), payoffs[i].end(), payoffs_.begin() + i * n_);
+        }
+    }
+
+    const Options& options() const { return options_; }
+
+    // Generations 0 .. generations - 1, starting from the given shares at generation 0
+    Result run(std::vector<double> shares, int generations) const {
+        if (shares.size() != n_) throw std::invalid_argument("Population size does not match the payoff matrix");
+
+        Result result;
+        const bool detect = options_.tolerance > 0.0;
+        const int period_limit = std::max(1, options_.max_period);
+        std::vector<std::vector<double>> recent; // ring buffer of the last period_limit generations
+
+        Active active;
+        pack(shares, active);
+        std::vector<double> x, fitness;
+        RungeKutta rk;
+
+        auto record = [&](int gen) {
+            result.trajectory.push_back(shares);
+            result.generations.push_back(gen);
+        };
+        if (generations > 0) record(0);
+
+        for (int gen = 1; gen < generations; ++gen) {
+            if (detect) {
+                if (recent.size() < static_cast<std::size_t>(period_limit)) recent.push_back(shares);
+                else recent[(gen - 1) % period_limit] = shares;
+            }
+
+            std::size_t extinct = 0;
+            for (std::size_t a = 0; a < active.size(); ++a) {
+                if (shares[active.index[a]] < options_.extinction) ++extinct;
+            }
+            if (4 * extinct >= active.size() && extinct > 0) pack(shares, active);
+
+            if (options_.method == ReplicatorMethod::RK45) {
+                result.steps += continuousStep(active, shares, rk);
+            }
+            else if (discreteStep(active, shares, x, fitness)) {
+                ++result.steps;
+            }
+            else {
+                result.stalled = true;
+            }
+
+            if (detect) {
+                // recent holds generations gen - 1 back to gen - recent.size()
+                for (int p = 1; p <= static_cast<int>(recent.size()); ++p) {
+                    if (sameShares(shares, recent[(gen - p) % period_limit], options_.tolerance)) {
+                        result.converged_at = gen;
+                        result.period = p;
+                        break;
+                    }
+                }
+            }
+
+            bool last = gen == generations - 1 || result.converged_at >= 0;
+            if (last || (options_.record_every > 0 && gen % options_.record_every == 0)) {
+                record(gen);
+            }
+            if (result.converged_at >= 0) break;
+        }
+        return result;
+    }
+};
+
+#endif // REPLICATORSOLVER_H
@@ -0,0 +1,287 @@
+﻿#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "OutcomeTensor.h"
+#include "Random.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Persistent, memory-mapped cache of per-pairing match results
+ *
+ * Maps a 128-bit fingerprint of everything that decides a block of games to the
+ * OutcomeTensor::Cell of those games. The fingerprint covers both strategies' cacheId(),
+ * the pairing's random stream, the repeat range, rounds, noise, RNG engine, exact mode and
+ * ENGINE_VERSION (see Simulator::cacheKey). A cell holds outcome counts, so payoffs and
+ * SCB costs are applied afterwards and are not part of the key: re-running with new
+ * payoffs still hits.
+ *
+ * The file is an open-addressing hash table with linear probing: a 64-byte header
+ * ("PDCACHE1", format version, slot size, capacity, record count) followed by
+ * `capacity` slots, mapped into memory with mmap or MapViewOfFile. It doubles when half
+ * full. Lookups and inserts from tournament tasks take one mutex; a block of games costs
+ * far more than the lock. One process at a time may use a cache file: it is opened for
+ * exclusive access (share mode 0 on Windows, an flock elsewhere), and a second process
+ * gets an error instead of a mapping that the first one may remap under it.
+ */
+class ResultCache {
+public:
+    // Bump when a change to the match engines changes the games they play
+    static constexpr std::uint32_t ENGINE_VERSION = 2; // 2: mt19937 is the 32-bit engine
+
+    struct Key {
+        std::uint64_t lo = 0;
+        std::uint64_t hi = 0;
+    };
+
+    // Fingerprint of a serialized key; never all zero, which marks empty slots
+    static Key fingerprint(const std::string& bytes) {
+        Key key;
+        key.lo = hashBytes(bytes, 0x5044434143484531ull) | 1u;
+        key.hi = hashBytes(bytes, 0x9E3779B97F4A7C15ull);
+        return key;
+    }
+
+private:
+    static constexpr char MAGIC[8] = { 'P', 'D', 'C', 'A', 'C', 'H', 'E', '1' };
+    static constexpr std::uint32_t FORMAT_VERSION = 2; // 2: cells hold mean counts and centered moments
+    static constexpr std::size_t HEADER_BYTES = 64;
+    static constexpr std::uint64_t INITIAL_CAPACITY = 1024;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t slot_bytes;
+        std::uint64_t capacity;
+        std::uint64_t count;
+    };
+
+    struct Slot {
+        Key key;
+        OutcomeTensor::Cell cell;
+    };
+
+    std::string path_;
+    std::mutex mutex_;
+    char* data_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+
+    static std::uint64_t hashBytes(const std::string& bytes, std::uint64_t seed) {
+        std::uint64_t h = seed;
+        for (std::size_t i = 0; i < bytes.size(); i += 8) {
+            std::uint64_t chunk = 0;
+            std::memcpy(&chunk, bytes.data() + i, std::min<std::size_t>(8, bytes.size() - i));
+            h = splitmix64(h ^ chunk);
+        }
+        return splitmix64(h ^ bytes.size());
+    }
+
+    static std::size_t fileBytes(std::uint64_t capacity) {
+        return HEADER_BYTES + static_cast<std::size_t>(capacity) * sizeof(Slot);
+    }
+
+    Header& header() { return *reinterpret_cast<Header*>(data_); }
+    Slot* slots() { return reinterpret_cast<Slot*>(data_ + HEADER_BYTES); }
+
+    // Map the first `bytes` of the file, growing the file to that size if needed
+    void map(std::size_t bytes) {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(bytes);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE,
+                                      static_cast<DWORD>(size.HighPart), size.LowPart, nullptr);
+        if (!mapping_) throw std::runtime_error("Cannot map result cache " + path_);
+        data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+        if (!data_) {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+            throw std::runtime_error("Cannot map result cache " + path_);
+        }
+#else
+        struct stat info;
+        if (fstat(fd_, &info) != 0) throw std::runtime_error("Cannot read result cache " + path_);
+        if (static_cast<std::size_t>(info.st_size) < bytes && ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error("Cannot grow result cache " + path_);
+        }
+        void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED) throw std::runtime_error("Cannot map result cache " + path_);
+        data_ = static_cast<char*>(view);
+#endif
+        mapped_bytes_ = bytes;
+    }
+
+    void unmap() {
+        if (!data_) return;
+#ifdef _WIN32
+        FlushViewOfFile(data_, 0);
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        munmap(data_, mapped_bytes_);
+#endif
+        data_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+
+    void close() {
+        unmap();
+#ifdef _WIN32
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+    }
+
+    std::size_t existingBytes() const {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        return GetFileSizeEx(file_, &size) ? static_cast<std::size_t>(size.QuadPart) : 0;
+#else
+        struct stat info;
+        return fstat(fd_, &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+#endif
+    }
+
+    // Map an empty table of the given capacity over the whole file
+    void initialize(std::uint64_t capacity) {
+        map(fileBytes(capacity));
+        std::memset(data_, 0, mapped_bytes_);
+        std::memcpy(header().magic, MAGIC, sizeof(MAGIC));
+        header().version = FORMAT_VERSION;
+        header().slot_bytes = static_cast<std::uint32_t>(sizeof(Slot));
+        header().capacity = capacity;
+        header().count = 0;
+    }
+
+    // Slot holding `key`, or the empty slot where it belongs
+    Slot& probe(const Key& key) {
+        const std::uint64_t mask = header().capacity - 1;
+        for (std::uint64_t i = key.lo & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots()[i];
+            if ((slot.key.lo == key.lo && slot.key.hi == key.hi) || slot.key.lo == 0) return slot;
+        }
+    }
+
+    // Double the table: keep the records, remap the larger file and insert them again
+    void grow() {
+        std::vector<Slot> records;
+        records.reserve(static_cast<std::size_t>(header().count));
+        for (std::uint64_t i = 0; i < header().capacity; ++i) {
+            if (slots()[i].key.lo != 0) records.push_back(slots()[i]);
+        }
+        const std::uint64_t capacity = header().capacity * 2;
+        unmap();
+        initialize(capacity);
+        for (const Slot& record : records) probe(record.key) = record;
+        header().count = records.size();
+    }
+
+public:
+    // Open or create the cache file; a file of another format is started afresh
+    explicit ResultCache(const std::string& path) : path_(path) {
+        static_assert(sizeof(Header) <= HEADER_BYTES, "Cache header does not fit");
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open result cache " + path);
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) throw std::runtime_error("Cannot open result cache " + path);
+        if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+            close();
+            throw std::runtime_error("Result cache " + path + " is in use by another process");
+        }
+#endif
+        try {
+            const std::size_t existing = existingBytes();
+            if (existing >= HEADER_BYTES) {
+                map(existing);
+                const Header& h = header();
+                bool valid = std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0 && h.version == FORMAT_VERSION
+                    && h.slot_bytes == sizeof(Slot) && h.capacity >= INITIAL_CAPACITY
+                    && (h.capacity & (h.capacity - 1)) == 0 && fileBytes(h.capacity) <= existing;
+                if (valid) return;
+                std::cerr << "Warning: " << path << " is not a result cache of this version; starting it afresh.\n";
+                unmap();
+            }
+            initialize(INITIAL_CAPACITY);
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    ~ResultCache() {
+        close();
+    }
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Copy the cached games of `key` into `cell`; false if there are none
+    bool find(const Key& key, OutcomeTensor::Cell& cell) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Slot& slot = probe(key);
+        if (slot.key.lo == 0) return false;
+        ++hits_;
+        cell = slot.cell;
+        return true;
+    }
+
+    void insert(const Key& key, const OutcomeTensor::Cell& cell) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (2 * (header().count + 1) > header().capacity) grow();
+        // The key goes in last: a run killed part-way leaves no key without its games
+        Slot& slot = probe(key);
+        const bool fresh = slot.key.lo == 0;
+        ++misses_; // every inserted cell was simulated, found or not (raw samples skip the lookup)
+        slot.cell = cell;
+        std::atomic_signal_fence(std::memory_order_release); // keep the compiler from reordering the stores
+        slot.key = key;
+        if (fresh) ++header().count;
+    }
+
+    const std::string& path() const { return path_; }
+    std::size_t hits() const { return hits_; }
+    std::size_t misses() const { return misses_; }
+    std::size_t records() { std::lock_guard<std::mutex> lock(mutex_); return static_cast<std::size_t>(header().count); }
+    std::size_t bytes() const { return mapped_bytes_; }
+};
+
+#endif // RESULTCACHE_H
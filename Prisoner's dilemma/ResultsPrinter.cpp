@@ -33,8 +33,13 @@ void ResultsPrinter::printConfiguration(const std::vector<std::unique_ptr<Strate
     // Simulation configuration
     table.add_row({ "Rounds per match", std::to_string(config_.rounds) });
     table.add_row({ "Repeats per match", std::to_string(config_.repeats) });
+    if (config_.ci_target > 0.0) {
+        table.add_row({ "Adaptive repeats", "until 95% CI half-width <= " + formatDouble(config_.ci_target, 3)
+                                            + ", at most " + std::to_string(config_.max_repeats) });
+    }
     table.add_row({ "Epsilon", std::to_string(config_.epsilon) });
     table.add_row({ "Random seed", std::to_string(config_.seed) });
+    table.add_row({ "RNG engine", config_.rng });
 
     // Payoff values
     table.add_row({ "Payoffs (T,R,P,S)",
@@ -54,6 +59,43 @@ void ResultsPrinter::printConfiguration(const std::vector<std::unique_ptr<Strate
     // Evolution parameters
     if (config_.evolve) {
         table.add_row({ "Generations", std::to_string(config_.generations) });
+        table.add_row({ "Replicator dynamics", config_.replicator });
+    }
+
+    // Island model parameters
+    if (config_.islands > 0) {
+        table.add_row({ "Islands", std::to_string(config_.islands) + " (" +
+                                   (config_.finite.empty() ? config_.replicator + " replicator" : config_.finite) + " dynamics)" });
+        table.add_row({ "Migration", formatDouble(config_.migration_rate, 3) + " of each island every "
+                                     + std::to_string(config_.migration_every) + " generations" });
+        table.add_row({ "Generations", std::to_string(config_.generations) });
+    }
+
+    // Genetic search parameters
+    if (config_.optimize) {
+        table.add_row({ "Genetic search", "memory-" + std::to_string(config_.optimize_depth) + " lookup tables, "
+                                          + std::to_string(config_.ga_population) + " genomes, mutation "
+                                          + formatDouble(config_.mutation_rate, 3) });
+        table.add_row({ "Generations", std::to_string(config_.generations) });
+    }
+
+    // Finite population parameters
+    if (!config_.finite.empty()) {
+        table.add_row({ "Finite population", config_.finite + ", N = " + std::to_string(config_.population) });
+        table.add_row({ "Selection intensity", formatDouble(config_.selection, 3) });
+    }
+
+    // Graph evolution parameters
+    if (!config_.graph.empty()) {
+        table.add_row({ "Graph", config_.graph + " (" + config_.graph_update + " updates)" });
+        table.add_row({ "Generations", std::to_string(config_.generations) });
+    }
+
+    // Spatial lattice parameters
+    if (config_.lattice > 0) {
+        table.add_row({ "Lattice", std::to_string(config_.lattice) + " x " + std::to_string(config_.lattice)
+                                   + " torus, " + config_.neighborhood });
+        table.add_row({ "Generations", std::to_string(config_.generations) });
     }
 
     // Format table
@@ -128,10 +170,19 @@ std::vector<std::pair<std::string, DoubleScoreStats>> sorted_results(results.beg
 std::sort(sorted_results.begin(), sorted_results.end(),
     [](const auto& a, const auto& b) { return a.second.mean > b.second.mean; });
 
-    std::cout << "Based on " << config_.repeats << " repeated experiments\n\n";
+    if (config_.ci_target > 0.0) {
+        std::cout << "Based on adaptive repeats: each pairing played until its 95% CI half-width was at most "
+                  << formatDouble(config_.ci_target, 3) << " (or " << config_.max_repeats << " repeats).\n"
+                  << "Pairings count equally in the means. The stratified CIs only cover the games' variance within\n"
+                  << "each pairing, 1.96 sqrt(sum s_k^2 / n_k) / K over K pairings, not the spread between pairings.\n\n";
+    }
+    else {
+        std::cout << "Based on " << config_.repeats << " repeated experiments\n\n";
+    }
 
     tabulate::Table table;
-    table.add_row({ "Rank", "Strategy", "Mean", "95% CI Lower", "95% CI Upper", "Std Dev" });
+    const std::string ci = hasStratifiedCI(results) ? "Stratified 95% CI" : "95% CI";
+    table.add_row({ "Rank", "Strategy", "Mean", ci + " Lower", ci + " Upper", "Std Dev" });
 
     int rank = 1;
     for (const auto& [name, stats] : sorted_results) {
@@ -205,6 +256,60 @@ void ResultsPrinter::printMatchTable(
     std::cout << table << std::endl;
 }
 
+void ResultsPrinter::printRepeatsSpent(
+    const std::vector<std::unique_ptr<Strategy>>& strategies,
+    const std::vector<int>& games,
+    const std::vector<double>& half_widths,
+    bool show_matrix) const {
+
+    if (games.empty()) return;
+
+    std::cout << "\n--- Repeats per Pairing (95% CI half-width <= " << formatDouble(config_.ci_target, 3) << ") ---\n";
+
+    if (show_matrix) {
+        tabulate::Table table;
+        std::vector<std::string> header = { "Strategy \\ Opponent" };
+        for (const auto& s : strategies) {
+            header.push_back(s->getName());
+        }
+        table.add_row({ header.begin(), header.end() });
+
+        // Pairings are stored once, from the side of the lower index
+        const size_t n = strategies.size();
+        auto at = [&](size_t i, size_t j) {
+            if (i > j) std::swap(i, j);
+            return i * (2 * n - i + 1) / 2 + (j - i);
+        };
+        for (size_t i = 0; i < n; ++i) {
+            std::vector<std::string> row = { strategies[i]->getName() };
+            for (size_t j = 0; j < n; ++j) {
+                row.push_back(std::to_string(games[at(i, j)]) + " (+/-" + formatDouble(half_widths[at(i, j)], 2) + ")");
+            }
+            table.add_row({ row.begin(), row.end() });
+        }
+
+        table.format()
+            .border_color(tabulate::Color::green)
+            .font_align(tabulate::FontAlign::center);
+        std::cout << table << std::endl;
+    }
+
+    std::vector<int> sorted = games;
+    std::sort(sorted.begin(), sorted.end());
+    long long total = 0;
+    size_t capped = 0;
+    for (int g : games) {
+        total += g;
+        if (g >= config_.max_repeats) ++capped;
+    }
+    std::cout << sorted.size() << " pairings: " << sorted.front() << " to " << sorted.back()
+              << " repeats (median " << sorted[sorted.size() / 2] << "), " << total << " in total; "
+              << capped << " stopped at --max-repeats. Playing every pairing " << config_.max_repeats
+              << " times would take " << static_cast<long long>(config_.max_repeats) * sorted.size() << ".\n";
+    std::cout << "Widest pairing CI half-width reached: "
+              << formatDouble(*std::max_element(half_widths.begin(), half_widths.end()), 3) << "\n";
+}
+
 // ==================== Noise Analysis Printing ====================
 
 void ResultsPrinter::printNoiseSweepTable(const std::map<double, std::map<std::string, DoubleScoreStats>>& results) const {
@@ -316,7 +421,10 @@ const std::string& filename) const {
     }
     
     // CSV header
-    file << "Epsilon,Strategy,Mean,StdDev,CI_Lower,CI_Upper\n";
+    const bool stratified = std::any_of(noise_results.begin(), noise_results.end(),
+        [](const auto& entry) { return hasStratifiedCI(entry.second); });
+    file << (stratified ? "Epsilon,Strategy,Mean,StdDev,Stratified_CI_Lower,Stratified_CI_Upper\n"
+                        : "Epsilon,Strategy,Mean,StdDev,CI_Lower,CI_Upper\n");
     
     // Write data
     for (const auto& [epsilon, results] : noise_results) {
@@ -804,7 +912,7 @@ void ResultsPrinter::printSCBEvolutionProgress(
     
     // Build header based on whether SCB is enabled
     std::vector<std::string> header = {"Strategy", "Population %"};
-    if (show_scb_costs && Strategy::isSCBEnabled()) {
+    if (show_scb_costs) {
         header.push_back("Complexity");
         header.push_back("SCB Cost/Round");
     }
@@ -826,7 +934,7 @@ void ResultsPrinter::printSCBEvolutionProgress(
         row.push_back(name);
         row.push_back(formatDouble(pop_percent, 2) + "%");
         
-        if (show_scb_costs && Strategy::isSCBEnabled()) {
+        if (show_scb_costs) {
             // Find strategy complexity
             double complexity = 0.0;
             for (const auto& s : strategies) {
@@ -836,7 +944,7 @@ void ResultsPrinter::printSCBEvolutionProgress(
                 }
             }
             
-            double cost_per_round = complexity * Strategy::getSCBCostFactor();
+            double cost_per_round = complexity * config_.scb_cost_factor;
             row.push_back(formatDouble(complexity, 1));
             row.push_back(formatDouble(cost_per_round, 3));
         }
@@ -874,6 +982,127 @@ void ResultsPrinter::printSCBEvolutionProgress(
     }
 }
 
+void ResultsPrinter::printReplicatorConvergence(int converged_at, int period) const {
+    if (converged_at >= 0) {
+        std::cout << "\n" << (period == 1 ? "Fixed point" : "Cycle of period " + std::to_string(period))
+                  << " reached at generation " << converged_at << " (" << config_.replicator << " dynamics); "
+                  << "skipping the remaining " << (config_.generations - 1 - converged_at) << " generations.\n";
+    }
+    else if (config_.convergence_tol > 0.0 && config_.payoff_refresh <= 0) {
+        std::cout << "\nNo fixed point or cycle within " << config_.generations << " generations ("
+                  << config_.replicator << " dynamics).\n";
+    }
+}
+
+void ResultsPrinter::printFixationResults(const std::vector<FixationEstimate>& estimates) const {
+    const double neutral = 1.0 / config_.population;
+    std::cout << "Population " << config_.population << ", selection intensity " << config_.selection
+              << ", " << config_.trajectories << " runs per pair; neutral fixation probability 1/N = "
+              << formatDouble(neutral, 6) << "\n\n";
+
+    tabulate::Table table;
+    table.add_row({ "Mutant", "Resident", "Fixations", "Probability", "95% CI", "vs 1/N",
+                    "Mean Generations", "Unresolved" });
+
+    for (const auto& estimate : estimates) {
+        table.add_row({
+            estimate.mutant,
+            estimate.resident,
+            std::to_string(estimate.fixations) + "/" + std::to_string(estimate.runs),
+            formatDouble(estimate.probability, 4),
+            "[" + formatDouble(estimate.ci_low, 4) + ", " + formatDouble(estimate.ci_high, 4) + "]",
+            formatDouble(estimate.probability / neutral, 2) + "x",
+            estimate.fixations > 0 ? formatDouble(estimate.mean_generations, 1) : "-",
+            std::to_string(estimate.unresolved)
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+    table[0].format()
+        .font_style({ tabulate::FontStyle::bold });
+
+    // Green when selection favours the mutant, red when it opposes it
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        if (estimates[i].ci_low > neutral) {
+            table[i + 1][0].format().font_color(tabulate::Color::green);
+        } else if (estimates[i].ci_high < neutral) {
+            table[i + 1][0].format().font_color(tabulate::Color::red);
+        }
+    }
+
+    std::cout << table << "\n";
+}
+
+void ResultsPrinter::printIslandSummary(
+    const std::vector<std::vector<double>>& shares,
+    const std::vector<std::unique_ptr<Strategy>>& strategies) const {
+
+    std::cout << "\n--- Final Shares by Island ---\n";
+
+    tabulate::Table table;
+    std::vector<std::string> header = { "Island" };
+    for (const auto& s : strategies) {
+        header.push_back(s->getName());
+    }
+    table.add_row({ header.begin(), header.end() });
+
+    std::vector<double> mean(strategies.size(), 0.0);
+    for (size_t island = 0; island < shares.size(); ++island) {
+        std::vector<std::string> row = { std::to_string(island) };
+        for (size_t i = 0; i < strategies.size(); ++i) {
+            row.push_back(formatDouble(shares[island][i], 3));
+            mean[i] += shares[island][i] / shares.size();
+        }
+        table.add_row({ row.begin(), row.end() });
+    }
+    std::vector<std::string> row = { "Mean" };
+    for (double share : mean) {
+        row.push_back(formatDouble(share, 3));
+    }
+    table.add_row({ row.begin(), row.end() });
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+    table[0].format()
+        .font_style({ tabulate::FontStyle::bold });
+    table[shares.size() + 1].format()
+        .font_style({ tabulate::FontStyle::bold });
+
+    std::cout << table << "\n";
+}
+
+void ResultsPrinter::printOptimizationHistory(const std::vector<OptimizationStep>& steps) const {
+    if (steps.empty()) return;
+
+    std::cout << "\n--- Genetic Search History ---\n";
+
+    tabulate::Table table;
+    table.add_row({ "Generation", "Best fitness", "Mean fitness", "Scored", "Best strategy" });
+
+    // Deep tables have long names; the full name of the winner is printed below
+    const size_t max_name = 40;
+    const size_t every = std::max<size_t>(1, (steps.size() + 19) / 20);
+    for (size_t gen = 0; gen < steps.size(); ++gen) {
+        if (gen % every != 0 && gen != steps.size() - 1) continue;
+        const OptimizationStep& step = steps[gen];
+        std::string name = step.best.size() > max_name ? step.best.substr(0, max_name - 3) + "..." : step.best;
+        table.add_row({ std::to_string(step.generation), formatDouble(step.best_fitness, 3),
+                        formatDouble(step.mean_fitness, 3), std::to_string(step.scored), name });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+    table[0].format()
+        .font_style({ tabulate::FontStyle::bold });
+
+    std::cout << table << "\n";
+    std::cout << "Best strategy: " << steps.back().best << " (fitness " << formatDouble(steps.back().best_fitness, 3) << ")\n";
+}
+
 // ==================== SCB (Strategic Complexity Budget) Printing ====================
 
 void ResultsPrinter::printComplexityTable(const std::vector<std::unique_ptr<Strategy>>& strategies) const {
@@ -915,9 +1144,9 @@ void ResultsPrinter::printComplexityTable(const std::vector<std::unique_ptr<Stra
     std::cout << "  2.5 - Moderate complexity (state tracking + logic)\n";
     std::cout << "  3.5 - High complexity (multi-round memory, noise handling, probing)\n\n";
     
-    if (Strategy::isSCBEnabled()) {
+    if (config_.enable_scb) {
         std::cout << "SCB Status: ENABLED\n";
-        std::cout << "Cost Factor: " << formatDouble(Strategy::getSCBCostFactor(), 2) 
+        std::cout << "Cost Factor: " << formatDouble(config_.scb_cost_factor, 2) 
                   << " per complexity unit per round\n";
         std::cout << "Formula: adjusted_score = raw_score - (complexity × cost_factor × rounds)\n\n";
     } else {
@@ -1023,7 +1252,7 @@ const std::map<std::string, DoubleScoreStats>& results_with_scb) const {
     std::cout << table << "\n\n";
 
     std::cout << "Notes:\n";
-    std::cout << "  - Cost factor = " << formatDouble(Strategy::getSCBCostFactor(), 2) 
+    std::cout << "  - Cost factor = " << formatDouble(config_.scb_cost_factor, 2) 
               << " per complexity unit per round\n";
     std::cout << "  - Rounds per match = " << config_.rounds << "\n";
     std::cout << "  - ↑ indicates rank improvement, ↓ indicates rank decline\n";
@@ -1039,6 +1268,7 @@ int repeats) const {
     std::cout << "\n=================================================\n";
     std::cout << "   Noise Impact on Exploitation\n";
     std::cout << "=================================================\n\n";
+    std::cout << "Mean scores over " << repeats << " matches per victim and noise level\n\n";
     
     // Get list of victims
     std::vector<std::string> victim_names;
@@ -1115,3 +1345,215 @@ int repeats) const {
     
     std::cout << table << "\n\n";  
 }
+
+// ==================== Payoff Grid Printing ====================
+
+void ResultsPrinter::printPayoffGridResults(
+const std::vector<PayoffGridPoint<double>>& grid,
+size_t combinations) const {
+
+    std::cout << "Re-scored " << grid.size() << " valid payoff matrices out of " << combinations
+              << " combinations from one simulation (T > R > P > S and 2R > T + S).\n\n";
+    if (grid.empty()) {
+        return;
+    }
+
+    // Collect all strategy names
+    std::vector<std::string> strategy_names;
+    for (const auto& [strategy, _] : grid.front().stats) {
+        strategy_names.push_back(strategy);
+    }
+
+    tabulate::Table table;
+    std::vector<std::string> header = { "T", "R", "P", "S" };
+    for (const auto& name : strategy_names) {
+        header.push_back(name);
+    }
+    header.push_back("Winner");
+    table.add_row({ header.begin(), header.end() });
+
+    table[0].format()
+        .font_style({ tabulate::FontStyle::bold })
+        .font_align(tabulate::FontAlign::center)
+        .font_color(tabulate::Color::yellow);
+
+    // Count how often each strategy wins across the grid
+    std::map<std::string, int> wins;
+    for (const auto& point : grid) {
+        std::vector<std::string> row = {
+            formatDouble(point.payoffs.getTemptation()),
+            formatDouble(point.payoffs.getReward()),
+            formatDouble(point.payoffs.getPunishment()),
+            formatDouble(point.payoffs.getSucker())
+        };
+        std::string winner;
+        double best = 0.0;
+        for (const auto& name : strategy_names) {
+            double mean = point.stats.at(name).mean;
+            row.push_back(formatDouble(mean));
+            if (winner.empty() || mean > best) {
+                winner = name;
+                best = mean;
+            }
+        }
+        row.push_back(winner);
+        ++wins[winner];
+        table.add_row({ row.begin(), row.end() });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n\n";
+
+    std::cout << "Wins across the grid:\n";
+    for (const auto& [name, count] : wins) {
+        std::cout << "  " << std::setw(15) << std::left << name << ": " << count << " / " << grid.size() << "\n";
+    }
+    std::cout << std::right << "\n";
+}
+
+// ==================== Benchmark Printing ====================
+
+void ResultsPrinter::printBenchmarkResults(const std::vector<BenchmarkResult>& results) const {
+    std::cout << "Rounds per match: " << config_.rounds
+              << ", repeats per batch: " << config_.repeats
+              << ", epsilon: " << formatDouble(config_.epsilon, 3) << "\n\n";
+
+    tabulate::Table table;
+    table.add_row({ "Matchup", "Virtual (M rounds/s)", "Inlined (M rounds/s)", "FSM (M rounds/s)",
+                    "Bit-sliced (M rounds/s)", "Best Speedup" });
+
+    for (const auto& result : results) {
+        double best = std::max({ result.inlined_rounds_per_sec, result.fsm_rounds_per_sec,
+                                 result.bitsliced_rounds_per_sec });
+        double speedup = result.virtual_rounds_per_sec > 0.0 ? best / result.virtual_rounds_per_sec : 0.0;
+        table.add_row({
+            result.matchup,
+            formatDouble(result.virtual_rounds_per_sec / 1e6),
+            formatDouble(result.inlined_rounds_per_sec / 1e6),
+            result.fsm_rounds_per_sec > 0.0 ? formatDouble(result.fsm_rounds_per_sec / 1e6) : "-",
+            result.bitsliced_rounds_per_sec > 0.0 ? formatDouble(result.bitsliced_rounds_per_sec / 1e6) : "-",
+            formatDouble(speedup) + "x"
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n\n";
+}
+
+void ResultsPrinter::printRngBenchmark(const std::vector<RngBenchmarkResult>& engines) const {
+    std::cout << "--- RNG Engines (--rng) ---\n\n";
+
+    tabulate::Table table;
+    table.add_row({ "Engine", "Engine State (bytes)", "StrategyState (bytes)", "Draws (M/s)", "Uniforms (M/s)" });
+    for (const auto& engine : engines) {
+        table.add_row({
+            engine.engine + (engine.engine == config_.rng ? " *" : ""),
+            std::to_string(engine.engine_bytes),
+            std::to_string(engine.state_bytes),
+            formatDouble(engine.draws_per_sec / 1e6),
+            formatDouble(engine.uniforms_per_sec / 1e6)
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n";
+    std::cout << "* engine selected for this run\n\n";
+}
+
+void ResultsPrinter::printNoiseSamplingCheck(const std::vector<NoiseSamplingCheck>& checks, int block_moves) const {
+    std::cout << "--- Noise Sampling: per-move draw vs geometric flip countdown ---\n";
+    if (!checks.empty()) {
+        std::cout << checks.front().moves << " moves per sampler and level, chi-square over flips per "
+                  << block_moves << " moves; PASS when both p-values exceed 0.001\n\n";
+    }
+
+    tabulate::Table table;
+    table.add_row({ "Epsilon", "Per-move Rate", "Geometric Rate", "Rate p-value", "Chi-square (dof)",
+                    "Block p-value", "Per-move (M moves/s)", "Geometric (M moves/s)", "Result" });
+
+    for (const auto& check : checks) {
+        bool pass = check.rate_p_value > 0.001 && check.block_p_value > 0.001;
+        table.add_row({
+            formatDouble(check.epsilon, 3),
+            formatDouble(check.bernoulli_rate, 5),
+            formatDouble(check.geometric_rate, 5),
+            formatDouble(check.rate_p_value, 3),
+            formatDouble(check.block_chi_square) + " (" + std::to_string(check.block_dof) + ")",
+            formatDouble(check.block_p_value, 3),
+            formatDouble(check.bernoulli_moves_per_sec / 1e6),
+            formatDouble(check.geometric_moves_per_sec / 1e6),
+            pass ? "PASS" : "FAIL"
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n\n";
+}
+
+void ResultsPrinter::printTournamentScaling(const std::vector<TournamentScalingResult>& runs) const {
+    std::cout << "--- Large Tournaments: copies of the selected strategies, " << config_.rounds
+              << " rounds, 1 game per pairing ---\n\n";
+
+    tabulate::Table table;
+    table.add_row({ "Strategies", "Pairings", "Time (s)", "Pairings/s", "Outcome tensor (MB)", "Full N x N (MB)" });
+
+    for (const auto& run : runs) {
+        table.add_row({
+            std::to_string(run.strategies),
+            std::to_string(run.pairings),
+            formatDouble(run.seconds, 3),
+            formatDouble(run.seconds > 0.0 ? run.pairings / run.seconds : 0.0, 0),
+            formatDouble(run.tensor_bytes / 1048576.0, 1),
+            formatDouble(run.full_bytes / 1048576.0, 1)
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n\n";
+}
+
+void ResultsPrinter::printReplicatorBenchmark(const std::vector<ReplicatorBenchmarkResult>& runs, int max_generations) const {
+    std::cout << "--- Replicator Solver: random payoff matrices, up to " << max_generations << " generations ---\n";
+    std::cout << "Runs stop at the first fixed point or cycle within a tolerance of " << config_.convergence_tol << "\n\n";
+
+    tabulate::Table table;
+    table.add_row({ "Method", "Strategies", "Stopped at", "Outcome", "Steps", "Survivors", "Time (s)", "ms/generation" });
+
+    for (const auto& run : runs) {
+        std::string outcome = run.period == 0 ? "not converged"
+                            : run.period == 1 ? "fixed point"
+                            : "cycle of " + std::to_string(run.period);
+        double per_generation = run.generations > 0 ? run.seconds * 1000.0 / run.generations : 0.0;
+        table.add_row({
+            run.method,
+            std::to_string(run.strategies),
+            std::to_string(run.generations),
+            outcome,
+            std::to_string(run.steps),
+            std::to_string(run.survivors),
+            formatDouble(run.seconds, 3),
+            formatDouble(per_generation, 4)
+        });
+    }
+
+    table.format()
+        .font_align(tabulate::FontAlign::center)
+        .border_color(tabulate::Color::cyan);
+
+    std::cout << table << "\n\n";
+}
@@ -8,6 +8,72 @@
 #include "Config.h"
 #include "Strategy.h"
 #include "Simulator.h"
+#include "GeneticOptimizer.h"
+
+/// Fixation of a single mutant among N - 1 residents, over many runs (--finite)
+struct FixationEstimate {
+    std::string mutant;
+    std::string resident;
+    int runs = 0;
+    int fixations = 0;             // runs in which the mutant took over
+    int unresolved = 0;            // runs still mixed after --fixation-generations
+    double probability = 0.0;
+    double ci_low = 0.0;           // 95% Wilson interval
+    double ci_high = 0.0;
+    double mean_generations = 0.0; // mean generations to fixation, over the fixing runs
+};
+
+/// Throughput of each match path for one strategy pair (--benchmark)
+struct BenchmarkResult {
+    std::string matchup;
+    double virtual_rounds_per_sec = 0.0;
+    double inlined_rounds_per_sec = 0.0;
+    double fsm_rounds_per_sec = 0.0;     // 0 when either strategy has no FSM form
+    double bitsliced_rounds_per_sec = 0.0; // 0 when either strategy has no FSM form
+};
+
+/// Memory and throughput of one RNG engine (--benchmark)
+struct RngBenchmarkResult {
+    std::string engine;
+    size_t engine_bytes = 0;        // state of the engine itself
+    size_t state_bytes = 0;         // whole StrategyState, including heap-allocated engine state
+    double draws_per_sec = 0.0;     // raw 64-bit outputs
+    double uniforms_per_sec = 0.0;  // StrategyState::uniform()
+};
+
+/// Per-move Bernoulli noise draws vs the geometric flip countdown at one noise level (--benchmark)
+struct NoiseSamplingCheck {
+    double epsilon = 0.0;
+    long long moves = 0;                 // moves sampled by each method
+    double bernoulli_rate = 0.0;         // observed flip rate, one uniform draw per move
+    double geometric_rate = 0.0;         // observed flip rate, StrategyState::flipNext
+    double rate_p_value = 0.0;           // two-proportion z-test
+    double block_chi_square = 0.0;       // homogeneity of the flips-per-block distributions
+    int block_dof = 0;
+    double block_p_value = 0.0;
+    double bernoulli_moves_per_sec = 0.0;
+    double geometric_moves_per_sec = 0.0;
+};
+
+/// One replicator-dynamics run on a random payoff matrix (--benchmark)
+struct ReplicatorBenchmarkResult {
+    std::string method;
+    int strategies = 0;
+    int generations = 0;          // generation at which the run stopped
+    int period = 0;               // 1 = fixed point, > 1 = cycle, 0 = not converged
+    long long steps = 0;          // discrete updates or accepted RK45 steps
+    int survivors = 0;            // strategies with a non-zero final share
+    double seconds = 0.0;
+};
+
+/// Time and outcome storage of one large tournament (--benchmark)
+struct TournamentScalingResult {
+    int strategies = 0;
+    long long pairings = 0;       // pairings i <= j, one game each
+    std::size_t tensor_bytes = 0; // upper-triangular outcome tensor
+    std::size_t full_bytes = 0;   // the same data as a full N x N table with 4 x 4 moments
+    double seconds = 0.0;
+};
 
 /**
  * @class ResultsPrinter
@@ -37,6 +103,15 @@ public:
     void printMatchTable(
         const std::vector<std::unique_ptr<Strategy>>& strategies,
         const std::vector<std::vector<std::pair<double, double>>>& matchResults) const;
+
+    /// Print the repeats each pairing took under --ci-target and the 95% CI half-width they
+    /// reached (pairings i <= j, row by row), as a matrix if show_matrix, and how they
+    /// compare with --max-repeats for every pairing
+    void printRepeatsSpent(
+        const std::vector<std::unique_ptr<Strategy>>& strategies,
+        const std::vector<int>& games,
+        const std::vector<double>& half_widths,
+        bool show_matrix) const;
     
     // ==================== Noise Analysis Printing ====================
     
@@ -102,6 +177,20 @@ public:
         const std::map<std::string, double>& populations,
         const std::vector<std::unique_ptr<Strategy>>& strategies,
         bool show_scb_costs = true) const;
+
+    /// Print the generation at which the replicator dynamics reached a fixed point or cycle
+    void printReplicatorConvergence(int converged_at, int period) const;
+
+    /// Print the fixation probability of each mutant/resident pair next to neutral drift (1/N)
+    void printFixationResults(const std::vector<FixationEstimate>& estimates) const;
+
+    /// Print the final population shares of every island and their mean
+    void printIslandSummary(
+        const std::vector<std::vector<double>>& shares,
+        const std::vector<std::unique_ptr<Strategy>>& strategies) const;
+
+    /// Print the best and mean fitness of the genetic search, about 20 generations of it
+    void printOptimizationHistory(const std::vector<OptimizationStep>& steps) const;
     
     // ==================== SCB (Strategic Complexity Budget) Printing ====================
     
@@ -114,6 +203,30 @@ public:
         const std::map<std::string, DoubleScoreStats>& results_with_scb) const;
     
 
+    // ==================== Benchmark Printing ====================
+    
+    /// Print rounds/sec of the virtual, inlined and FSM match paths
+    void printBenchmarkResults(const std::vector<BenchmarkResult>& results) const;
+
+    /// Print bytes per match state and draws/sec of every RNG engine
+    void printRngBenchmark(const std::vector<RngBenchmarkResult>& engines) const;
+
+    /// Print the statistical equivalence check and throughput of the two noise samplers
+    void printNoiseSamplingCheck(const std::vector<NoiseSamplingCheck>& checks, int block_moves) const;
+
+    /// Print generations to convergence and run time of the replicator solver
+    void printReplicatorBenchmark(const std::vector<ReplicatorBenchmarkResult>& runs, int max_generations) const;
+
+    /// Print the pairing throughput and outcome storage of large tournaments
+    void printTournamentScaling(const std::vector<TournamentScalingResult>& runs) const;
+
+    // ==================== Payoff Grid Printing ====================
+
+    /// Print each strategy's mean score for every valid payoff matrix of the grid
+    void printPayoffGridResults(
+        const std::vector<PayoffGridPoint<double>>& grid,
+        size_t combinations) const;
+
     // ==================== Utility Functions ====================
     
     /// Format double value to string (2 decimal places)
@@ -0,0 +1,142 @@
+﻿#include "SelfTest.h"
+#include "Simulator.h"
+#include "Strategies.h"
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SelfTest {
+
+namespace {
+
+// Fails the running check with a message
+struct Failure {
+    std::string what;
+};
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) throw Failure{ what };
+}
+
+bool sameCell(const OutcomeTensor::Cell& a, const OutcomeTensor::Cell& b) {
+    return a.games == b.games && a.mean.rounds == b.mean.rounds && a.moments == b.moments;
+}
+
+std::vector<StrategyPtr> makeStrategies(const std::vector<std::string>& names) {
+    std::vector<StrategyPtr> strategies;
+    for (const auto& name : names) {
+        if (name == "TFT") strategies.push_back(std::make_unique<TitForTat>());
+        else if (name == "GRIM") strategies.push_back(std::make_unique<GrimTrigger>());
+        else if (name == "ALLD") strategies.push_back(std::make_unique<AllDefect>());
+        else if (name == "RND") strategies.push_back(std::make_unique<RandomStrategy>(0.3));
+    }
+    return strategies;
+}
+
+int indexOf(const std::vector<std::string>& names, const std::string& name) {
+    for (std::size_t k = 0; k < names.size(); ++k) {
+        if (names[k] == name) return static_cast<int>(k);
+    }
+    return -1;
+}
+
+// Cell of strategies a and b from a's side, whichever of them comes first in the list
+OutcomeTensor::Cell cellOf(const OutcomeTensor& tensor, const std::vector<std::string>& names,
+                           const std::string& a, const std::string& b) {
+    int i = indexOf(names, a), j = indexOf(names, b);
+    return i <= j ? tensor.cell(i, j) : tensor.cell(j, i).swapped();
+}
+
+// Cached pairings are found again after strategies are prepended or reordered, and the
+// games of a pairing do not depend on the positions of its strategies
+void cacheIgnoresStrategyOrder() {
+    const std::string path = "pd_selftest_cache.bin";
+    std::remove(path.c_str());
+    {
+        Simulator<double> simulator(PayoffMatrix<double>(), 0.05);
+        auto cache = std::make_shared<ResultCache>(path);
+        simulator.setCache(cache);
+
+        const std::vector<std::string> first = { "TFT", "GRIM", "RND" };
+        OutcomeTensor base = simulator.runTournamentOutcomes(makeStrategies(first), 50, 20);
+        expect(cache->hits() == 0 && cache->misses() == 6, "first run should simulate all 6 pairings");
+
+        const std::vector<std::string> prepended = { "ALLD", "TFT", "GRIM", "RND" };
+        simulator.runTournamentOutcomes(makeStrategies(prepended), 50, 20);
+        expect(cache->hits() == 6 && cache->misses() == 10,
+               "prepending ALLD should reuse all 6 pairings and simulate only its 4");
+
+        const std::vector<std::string> reordered = { "RND", "ALLD", "GRIM", "TFT" };
+        simulator.setCache(nullptr);
+        OutcomeTensor fresh = simulator.runTournamentOutcomes(makeStrategies(reordered), 50, 20);
+        simulator.setCache(cache);
+        OutcomeTensor cached = simulator.runTournamentOutcomes(makeStrategies(reordered), 50, 20);
+        expect(cache->hits() == 16 && cache->misses() == 10, "reordering should reuse all 10 pairings");
+
+        for (const auto& a : first) {
+            for (const auto& b : first) {
+                expect(sameCell(cellOf(base, first, a, b), cellOf(fresh, reordered, a, b)),
+                       "pairing " + a + " vs " + b + " should play the same games in any order");
+                expect(sameCell(cellOf(fresh, reordered, a, b), cellOf(cached, reordered, a, b)),
+                       "cached pairing " + a + " vs " + b + " should match the simulated one");
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// LT1:3 is documented as TFT: it must play exactly TFT's games, with and without noise
+void lookupTableLT13IsTitForTat() {
+    StrategyPtr table = LookupTableStrategy::parse("LT1:3");
+    StrategyPtr tft = std::make_unique<TitForTat>();
+    for (double noise : { 0.0, 0.05 }) {
+        Simulator<double> simulator(PayoffMatrix<double>(), noise);
+        for (const auto& opponent : makeStrategies({ "TFT", "GRIM", "ALLD", "RND" })) {
+            for (int repeats : { 10, 100 }) { // scalar and bit-sliced engines
+                MatchHistory history;
+                auto expected = simulator.playPairingCounts(tft, opponent, 100, repeats, history,
+                                                            simulator.getContext(), 7, 0);
+                auto actual = simulator.playPairingCounts(table, opponent, 100, repeats, history,
+                                                          simulator.getContext(), 7, 0);
+                expect(actual.size() == expected.size(),
+                       "LT1:3 against " + opponent->getName() + " should play as many games as TFT");
+                for (std::size_t g = 0; g < expected.size(); ++g) {
+                    expect(actual[g].rounds == expected[g].rounds,
+                           "LT1:3 against " + opponent->getName() + " should play like TFT");
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int runAll() {
+    const std::vector<std::pair<std::string, std::function<void()>>> checks = {
+        { "result cache ignores strategy order", cacheIgnoresStrategyOrder },
+        { "LT1:3 plays tit-for-tat", lookupTableLT13IsTitForTat },
+    };
+
+    int failed = 0;
+    for (const auto& check : checks) {
+        try {
+            check.second();
+            std::cout << "PASS " << check.first << "\n";
+        }
+        catch (const Failure& failure) {
+            std::cout << "FAIL " << check.first << ": " << failure.what << "\n";
+            ++failed;
+        }
+        catch (const std::exception& e) {
+            std::cout << "FAIL " << check.first << ": " << e.what() << "\n";
+            ++failed;
+        }
+    }
+    std::cout << checks.size() - failed << " of " << checks.size() << " checks passed\n";
+    return failed;
+}
+
+} // namespace SelfTest
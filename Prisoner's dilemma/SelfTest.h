@@ -0,0 +1,14 @@
+﻿#ifndef SELFTEST_H
+#define SELFTEST_H
+
+/**
+ * @brief Built-in regression checks, run with --self-test
+ *
+ * Each check prints PASS or FAIL with the reason. runAll() returns the number of failed
+ * checks, so the exit code of --self-test is 0 only when all of them pass.
+ */
+namespace SelfTest {
+    int runAll();
+}
+
+#endif // SELFTEST_H
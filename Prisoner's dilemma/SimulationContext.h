@@ -0,0 +1,38 @@
+﻿#ifndef SIMULATIONCONTEXT_H
+#define SIMULATIONCONTEXT_H
+
+#include "RandomEngine.h"
+
+/**
+ * @brief Settings of one simulation run: noise level and SCB (Strategic Complexity Budget)
+ *
+ * Passed to the Simulator with every match or tournament instead of being held in
+ * globals, so experiments with different settings can run side by side in one process.
+ */
+struct SimulationContext {
+    double noise = 0.0;            // Error rate: probability that a player's move is flipped
+    bool enable_scb = false;       // Whether to enable Strategic Complexity Budget
+    double scb_cost_factor = 0.1;  // Cost coefficient per complexity unit per round
+    RngKind rng = RngKind::MT19937; // Engine of the match states and the bit-sliced noise masks
+
+    // Same settings at another noise level
+    SimulationContext withNoise(double epsilon) const {
+        SimulationContext context = *this;
+        context.noise = epsilon;
+        return context;
+    }
+
+    // Same settings with SCB switched on or off
+    SimulationContext withSCB(bool enable) const {
+        SimulationContext context = *this;
+        context.enable_scb = enable;
+        return context;
+    }
+
+    // SCB cost of a whole match for a strategy of the given complexity (0 if SCB is disabled)
+    double complexityCost(double complexity, int rounds) const {
+        return enable_scb ? complexity * scb_cost_factor * rounds : 0.0;
+    }
+};
+
+#endif // SIMULATIONCONTEXT_H
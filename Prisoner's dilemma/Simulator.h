@@ -2,7 +2,17 @@
 #define SIMULATOR_H
 #include <sstream>
 #include "Strategy.h"
+#include "StrategyDispatch.h"
+#include "FSMKernel.h"
+#include "BitSlicedKernel.h"
+#include "MemoryOneChain.h"
+#include "OutcomeCounts.h"
+#include "OutcomeTensor.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include "SimulationContext.h"
 #include "PayoffMatrix.h"
+#include "ResultCache.h"
 #include <iostream>
 #include <iomanip>
 #include <map>
@@ -14,6 +24,7 @@
 #include <random>
 #include <tabulate/table.hpp>
 #include <numeric>
+#include <cstring>
 
 // Template type aliases
 template<typename ScoreType = double>
@@ -33,11 +44,46 @@ struct ScoreStats {
     ScoreType ci_lower;
     ScoreType ci_upper;
     int n_samples;
+    bool stratified_ci = false; // CI from the pairings' own variances (adaptive repeats), see scoreTournament
 
     ScoreStats() : mean(0), stdev(0), ci_lower(0), ci_upper(0), n_samples(0) {}
     
     ScoreStats(ScoreType m, ScoreType sd, ScoreType ci_low, ScoreType ci_high, int n)
         : mean(m), stdev(sd), ci_lower(ci_low), ci_upper(ci_high), n_samples(n) {}
+
+    // Mean, sample standard deviation and 95% CI of an accumulated set of scores
+    static ScoreStats fromMoments(const OutcomeTensor::ScoreMoments& m) {
+        ScoreStats stats;
+        stats.n_samples = static_cast<int>(m.games);
+        if (stats.n_samples == 0) return stats;
+
+        stats.mean = ScoreType(m.mean);
+        if (stats.n_samples > 1) {
+            double stdev = std::sqrt(m.variance());
+            double margin = 1.96 * (stdev / std::sqrt(m.games));
+            stats.stdev = ScoreType(stdev);
+            stats.ci_lower = ScoreType(m.mean - margin);
+            stats.ci_upper = ScoreType(m.mean + margin);
+        }
+        else {
+            stats.stdev = ScoreType(0);
+            stats.ci_lower = stats.ci_upper = stats.mean;
+        }
+        return stats;
+    }
+};
+
+// True if any of the statistics has a pairing-stratified CI, which output labels as such
+template<typename ScoreType>
+bool hasStratifiedCI(const std::map<std::string, ScoreStats<ScoreType>>& stats) {
+    return std::any_of(stats.begin(), stats.end(), [](const auto& entry) { return entry.second.stratified_ci; });
+}
+
+// Tournament statistics under one payoff matrix of a payoff grid
+template<typename ScoreType = double>
+struct PayoffGridPoint {
+    PayoffMatrix<ScoreType> payoffs;
+    std::map<std::string, ScoreStats<ScoreType>> stats;
 };
 
 /**
@@ -48,28 +94,312 @@ template<typename ScoreType = double>
 class Simulator {
 private:
     PayoffMatrix<ScoreType> payoff_matrix_;
-    double noise_level_;  // Current noise level
+    SimulationContext context_; // Default settings for calls that do not pass a context
+    std::uint64_t seed_ = 42; // Base seed for engines that own their RNG streams
+    bool exact_ = false;      // Use exact Markov-chain expectations for memory-one pairs
+    std::shared_ptr<ThreadPool> pool_ = std::make_shared<ThreadPool>(1);
+    std::shared_ptr<ResultCache> cache_; // Persistent per-pairing results, if any
+    double ci_target_ = 0.0;  // Adaptive repeats: 95% CI half-width each pairing should reach (0 = off)
+    int max_repeats_ = 10000; // Adaptive repeats: most games per pairing
+    bool keep_games_ = false; // Tournaments also keep the counts of every game (raw samples)
+
+    // Bit-sliced engine width: 4 x 64 = 256 repeats per block
+    using BitSlicedEngine = BitSlicedKernel<ScoreType, 4>;
+
+    // Tournament work unit: one pairing, up to this many repeats. Matches the bit-sliced
+    // block so a task's random streams do not depend on how the tasks are scheduled.
+    static constexpr int REPEAT_BLOCK = BitSlicedEngine::LANES;
+
+    // Largest tile of the pairing triangle played by one task: 32 x 32 strategies keeps
+    // their match kernels in cache while every pairing of the tile is played
+    static constexpr int PAIR_TILE = 32;
+
+    // Deterministic per-pairing RNG stream, independent of the order pairings are played in.
+    // Keyed by cacheId(), as tournament cells are: display names round mixed strategies'
+    // probabilities, so two distinct strategies could otherwise share a stream.
+    std::uint64_t pairingSeed(const Strategy& p1, const Strategy& p2) const {
+        return pairingSeed(p1.cacheId(), p2.cacheId());
+    }
+
+    std::uint64_t pairingSeed(const std::string& id1, const std::string& id2) const {
+        std::uint64_t h2 = fnv1a(id2);
+        return mixSeed(seed_, fnv1a(id1) ^ ((h2 << 1) | (h2 >> 63)));
+    }
 
-    ScoreType getScore(Move m1, Move m2) const {
-        return payoff_matrix_.getPayoff(m1, m2);
+    // One block of games of tournament pairing (i, j), i <= j, from strategy i's side. The
+    // pairing is played with its strategies in cacheId() order and seeded from their ids, so
+    // its games and cache key do not depend on where the two sit in the strategy list.
+    // With `kept`, the counts of every game are appended to it as well; the cache cannot
+    // supply those, so the games are played and only stored.
+    OutcomeTensor::Cell playTournamentCell(const std::vector<StrategyPtr>& strategies,
+                                           const std::vector<std::string>& ids, int i, int j,
+                                           int rounds, int repeats, MatchHistory& history,
+                                           const SimulationContext& context, int block,
+                                           std::vector<OutcomeCounts>* kept = nullptr) const {
+        const bool swap = ids[j] < ids[i];
+        const int first = swap ? j : i, second = swap ? i : j;
+        const std::uint64_t pairing_seed = pairingSeed(ids[first], ids[second]);
+        if (!kept) {
+            OutcomeTensor::Cell games = playPairingCell(strategies[first], strategies[second], rounds, repeats,
+                                                        history, context, pairing_seed, block);
+            return swap ? games.swapped() : games;
+        }
+
+        OutcomeTensor::Cell games;
+        for (OutcomeCounts counts : playPairingCounts(strategies[first], strategies[second], rounds, repeats,
+                                                      history, context, pairing_seed, block)) {
+            games.add(counts);
+            if (swap) std::swap(counts.rounds[1], counts.rounds[2]);
+            kept->push_back(counts);
+        }
+        if (cache_) {
+            cache_->insert(cacheKey(*strategies[first], *strategies[second], pairing_seed, block,
+                                    rounds, repeats, context), games);
+        }
+        return swap ? games.swapped() : games;
+    }
+
+    // SCB: If complexity cost is enabled, deduct it from final score
+    ScorePair<ScoreType> applyComplexityCost(const Strategy& p1, const Strategy& p2, ScorePair<ScoreType> scores,
+                                             int rounds, const SimulationContext& context) const {
+        if (context.enable_scb) {
+            ScoreType cost1 = ScoreType(context.complexityCost(p1.getComplexity(), rounds));
+            ScoreType cost2 = ScoreType(context.complexityCost(p2.getComplexity(), rounds));
+            scores.first -= cost1;
+            scores.second -= cost2;
+        }
+        return scores;
+    }
+
+    // Inner match loop. Noisy=false skips applyNoise, which is a no-op at zero noise anyway.
+    // Rounds are tallied by outcome; payoffs are applied once per match (see scoreGame).
+    template<bool Noisy, typename S1, typename S2>
+    OutcomeCounts playRoundsImpl(const S1& p1, const S2& p2, StrategyState& state1, StrategyState& state2,
+                                 int rounds, MatchHistory& history, double noise) const {
+        const History history1 = history.player1(); // player1's perspective: {my move, opponent's move}
+        const History history2 = history.player2();
+        OutcomeCounts counts;
+
+        for (int i = 1; i <= rounds; ++i) {
+            // Same as decideWithNoise, spelled out so decide() binds to the static type
+            Move move1 = p1.decide(history1, state1);
+            Move move2 = p2.decide(history2, state2);
+            if (Noisy) {
+                move1 = p1.applyNoise(move1, noise, state1);
+                move2 = p2.applyNoise(move2, noise, state2);
+            }
+
+            // Both perspectives read the same packed round
+            history.push(move1, move2);
+            counts.add(history.lastOutcome());
+        }
+
+        return counts;
+    }
+
+    // Longest window whose outcome codes fit in a 64-bit cycle key
+    static constexpr std::size_t MAX_CYCLE_WINDOW = 32;
+
+    // Joint match state between rounds: both snapshots plus the last `window` outcome codes
+    struct CycleKey {
+        std::uint64_t state1 = 0;
+        std::uint64_t state2 = 0;
+        std::uint64_t recent = 0;
+        bool operator==(const CycleKey& other) const {
+            return state1 == other.state1 && state2 == other.state2 && recent == other.recent;
+        }
+    };
+
+    // Noise-free loop with Brent's cycle detection on the joint state. Once a state repeats
+    // the match is periodic, so whole periods are added from the per-period counts and only
+    // the final partial period is played. Returns false (nothing played) if a strategy
+    // cannot snapshot its state or reads too far back.
+    template<typename S1, typename S2>
+    bool playRoundsCycle(const S1& p1, const S2& p2, StrategyState& state1, StrategyState& state2,
+                         int rounds, std::size_t window, MatchHistory& history, OutcomeCounts& counts) const {
+        const History history1 = history.player1();
+        const History history2 = history.player2();
+        CycleKey key;
+        if (window > MAX_CYCLE_WINDOW ||
+            !p1.snapshotState(history1, state1, key.state1) || !p2.snapshotState(history2, state2, key.state2)) {
+            return false;
+        }
+        const std::uint64_t recent_mask = window == MAX_CYCLE_WINDOW
+            ? ~std::uint64_t(0) : (std::uint64_t(1) << (2 * window)) - 1;
+
+        counts = OutcomeCounts();
+        CycleKey saved = key;
+        OutcomeCounts saved_counts = counts;
+        long long power = 1;
+        long long period = 0;
+
+        int i = 0;
+        while (i < rounds) {
+            history.push(p1.decide(history1, state1), p2.decide(history2, state2));
+            counts.add(history.lastOutcome());
+            ++i;
+
+            p1.snapshotState(history1, state1, key.state1);
+            p2.snapshotState(history2, state2, key.state2);
+            key.recent = ((key.recent << 2) | history.lastOutcome()) & recent_mask;
+            ++period;
+            if (key == saved) {
+                break;
+            }
+            if (period == power) {
+                saved = key;
+                saved_counts = counts;
+                power *= 2;
+                period = 0;
+            }
+        }
+
+        if (i < rounds) {
+            long long cycles = (rounds - i) / period;
+            counts += (counts - saved_counts) * static_cast<double>(cycles);
+            // The partial period is cheaper to play than to look up
+            for (long long left = (rounds - i) % period; left > 0; --left) {
+                history.push(p1.decide(history1, state1), p2.decide(history2, state2));
+                counts.add(history.lastOutcome());
+            }
+        }
+
+        return true;
+    }
+
+    // Count the outcomes of one match between two statically typed strategies
+    template<typename S1, typename S2>
+    OutcomeCounts countRounds(const S1& p1, const S2& p2, StrategyState& state1, StrategyState& state2,
+                              int rounds, MatchHistory& history, const SimulationContext& context) const {
+        // Keep only as many rounds as the more demanding strategy reads
+        std::size_t window = std::max(p1.getHistoryWindow(), p2.getHistoryWindow());
+        history.reset(window, static_cast<std::size_t>(rounds));
+
+        // The noise-free loop contains no RNG calls, so the counts stay in registers
+        OutcomeCounts counts;
+        if (context.noise != 0.0) {
+            counts = playRoundsImpl<true>(p1, p2, state1, state2, rounds, history, context.noise);
+        }
+        else if (!playRoundsCycle(p1, p2, state1, state2, rounds, window, history, counts)) {
+            counts = playRoundsImpl<false>(p1, p2, state1, state2, rounds, history, 0.0);
+        }
+        return counts;
     }
 
 public:
     // Constructor using PayoffMatrix (preferred)
     explicit Simulator(const PayoffMatrix<ScoreType>& matrix, double noise = 0.0) 
-        : payoff_matrix_(matrix), noise_level_(noise) {}
+        : payoff_matrix_(matrix) {
+        context_.noise = noise;
+    }
     
     // Constructor from vector (backward compatibility)
     explicit Simulator(const std::vector<ScoreType>& config, double noise = 0.0) 
-        : payoff_matrix_(config), noise_level_(noise) {}
+        : payoff_matrix_(config) {
+        context_.noise = noise;
+    }
 
     // Set noise level
     void setNoise(double epsilon) { 
-        noise_level_ = epsilon; 
+        context_.noise = epsilon; 
     }
 
     double getNoise() const { 
-        return noise_level_; 
+        return context_.noise; 
+    }
+
+    // Default noise and SCB settings, used by the overloads without a context argument
+    void setContext(const SimulationContext& context) {
+        context_ = context;
+    }
+
+    const SimulationContext& getContext() const {
+        return context_;
+    }
+
+    // Set the base seed used by the bit-sliced engine
+    void setSeed(std::uint64_t seed) {
+        seed_ = seed;
+    }
+
+    // Exact mode: memory-one pairings return their expected scores instead of samples
+    void setExact(bool exact) {
+        exact_ = exact;
+    }
+
+    bool isExact() const {
+        return exact_;
+    }
+
+    // Number of threads used by tournaments (0 = all hardware threads).
+    // Results do not depend on it.
+    void setThreads(unsigned threads) {
+        pool_ = std::make_shared<ThreadPool>(threads);
+    }
+
+    unsigned getThreads() const {
+        return pool_->size();
+    }
+
+    // The tournament pool, for other parallel work of the same run
+    ThreadPool& getThreadPool() const {
+        return *pool_;
+    }
+
+    // Adaptive repeats: after the fixed repeats, tournaments keep adding games to every
+    // pairing until the 95% CI half-width of both players' mean scores is at most
+    // ci_target or the pairing has max_repeats games (ci_target = 0: fixed repeats only)
+    void setCITarget(double ci_target, int max_repeats) {
+        ci_target_ = ci_target;
+        max_repeats_ = max_repeats;
+    }
+
+    double getCITarget() const {
+        return ci_target_;
+    }
+
+    // Raw samples: tournaments keep the outcome counts of every game in their tensor
+    // (see gameScores). Costs memory per game and bypasses cache lookups.
+    void setKeepGames(bool keep) {
+        keep_games_ = keep;
+    }
+
+    int getMaxRepeats() const {
+        return max_repeats_;
+    }
+
+    // Look pairings up in a persistent result cache before playing them (nullptr = off)
+    void setCache(std::shared_ptr<ResultCache> cache) {
+        cache_ = std::move(cache);
+    }
+
+    ResultCache* getCache() const {
+        return cache_.get();
+    }
+
+    // Cache fingerprint of `repeats` games of a pairing starting at block first_block of its
+    // random stream: everything that decides those games besides the strategies' code
+    ResultCache::Key cacheKey(const Strategy& p1, const Strategy& p2, std::uint64_t pairing_seed,
+                              int first_block, int rounds, int repeats, const SimulationContext& context) const {
+        std::string bytes = p1.cacheId();
+        bytes.push_back('\0');
+        bytes += p2.cacheId();
+        bytes.push_back('\0');
+        auto put = [&bytes](std::uint64_t value) {
+            for (int shift = 0; shift < 64; shift += 8) bytes.push_back(static_cast<char>(value >> shift));
+        };
+        std::uint64_t noise_bits;
+        std::memcpy(&noise_bits, &context.noise, sizeof(noise_bits));
+        put(ResultCache::ENGINE_VERSION);
+        put(seed_);
+        put(pairing_seed);
+        put(static_cast<std::uint64_t>(first_block));
+        put(static_cast<std::uint64_t>(repeats));
+        put(static_cast<std::uint64_t>(rounds));
+        put(noise_bits);
+        put(static_cast<std::uint64_t>(context.rng));
+        put(exact_ ? 1 : 0);
+        return ResultCache::fingerprint(bytes);
     }
     
     // Get the payoff matrix
@@ -77,149 +407,569 @@ public:
         return payoff_matrix_;
     }
 
-    // Run a single match, considering noise
+    // Run a single match, considering noise. Both players start from fresh match states
+    // seeded from this simulator's seed and the pairing.
     ScorePair<ScoreType> runGame(const StrategyPtr& p1, const StrategyPtr& p2, int rounds) const {
-        History history1;// player1's perspective: {my move, opponent's move}
-        History history2;
-        ScoreType score1 = ScoreType(0);
-        ScoreType score2 = ScoreType(0);
-        
-        for (int i = 1; i <= rounds; ++i) {
-            // Use decideWithNoise method to get decision with noise
-            Move move1 = p1->decideWithNoise(history1);
-            Move move2 = p2->decideWithNoise(history2);
-            
-            ScoreType round_score1 = getScore(move1, move2);
-            ScoreType round_score2 = getScore(move2, move1);
-            score1 += round_score1;
-            score2 += round_score2;
-            // update history, from each player's perspective
-            history1.push_back({ move1, move2 });  // player1: I play move1, opponent plays move2
-            history2.push_back({ move2, move1 });  // player2: I play move2, opponent plays move1
+        return runGame(p1, p2, rounds, context_);
+    }
+
+    // Same, with explicit noise and SCB settings
+    ScorePair<ScoreType> runGame(const StrategyPtr& p1, const StrategyPtr& p2, int rounds,
+                                 const SimulationContext& context) const {
+        std::uint64_t seed = pairingSeed(*p1, *p2);
+        StrategyState state1(mixSeed(seed, 1), context.rng);
+        StrategyState state2(mixSeed(seed, 2), context.rng);
+        MatchHistory history;
+        return runGame(p1, p2, state1, state2, rounds, history, context);
+    }
+
+    // Run a single match using caller-owned match states and history buffer (reused across repeats).
+    // The states must be reset() before each match.
+    // Built-in strategies take the inlined path; anything else falls back to virtual calls.
+    ScorePair<ScoreType> runGame(const StrategyPtr& p1, const StrategyPtr& p2,
+                                 StrategyState& state1, StrategyState& state2,
+                                 int rounds, MatchHistory& history, const SimulationContext& context) const {
+        return scoreGame(*p1, *p2, countGame(p1, p2, state1, state2, rounds, history, context),
+                         payoff_matrix_, context);
+    }
+
+    // Outcome counts of a single match; same dispatch as runGame
+    OutcomeCounts countGame(const StrategyPtr& p1, const StrategyPtr& p2,
+                            StrategyState& state1, StrategyState& state2,
+                            int rounds, MatchHistory& history, const SimulationContext& context) const {
+        OutcomeCounts counts;
+        bool dispatched = dispatchStrategyPair(*p1, *p2, [&](const auto& s1, const auto& s2) {
+            counts = countRounds(s1, s2, state1, state2, rounds, history, context);
+        });
+        if (!dispatched) {
+            counts = countRounds(*p1, *p2, state1, state2, rounds, history, context);
         }
+        return counts;
+    }
 
-        // SCB: If complexity cost is enabled, deduct it from final score
-        if (Strategy::isSCBEnabled()) {
-            ScoreType cost1 = ScoreType(p1->getComplexity() * Strategy::getSCBCostFactor() * rounds);
-            ScoreType cost2 = ScoreType(p2->getComplexity() * Strategy::getSCBCostFactor() * rounds);
-            score1 -= cost1;
-            score2 -= cost2;
+    // Benchmark: outcome counts of one match on the plain round loop (playRoundsImpl), with
+    // no cycle detection even at zero noise, so both variants time every round. With
+    // devirtualize, built-in strategies are dispatched to their final classes and decide()
+    // is inlined; otherwise every call goes through the virtual Strategy interface.
+    // The states must be reset() before each match.
+    OutcomeCounts countGameLoop(const StrategyPtr& p1, const StrategyPtr& p2,
+                                StrategyState& state1, StrategyState& state2, int rounds,
+                                MatchHistory& history, const SimulationContext& context, bool devirtualize) const {
+        OutcomeCounts counts;
+        auto loop = [&](const auto& s1, const auto& s2) {
+            history.reset(std::max(s1.getHistoryWindow(), s2.getHistoryWindow()), static_cast<std::size_t>(rounds));
+            counts = context.noise != 0.0
+                ? playRoundsImpl<true>(s1, s2, state1, state2, rounds, history, context.noise)
+                : playRoundsImpl<false>(s1, s2, state1, state2, rounds, history, 0.0);
+        };
+        if (!devirtualize || !dispatchStrategyPair(*p1, *p2, loop)) {
+            loop(static_cast<const Strategy&>(*p1), static_cast<const Strategy&>(*p2));
         }
+        return counts;
+    }
 
-        return { score1, score2 };
+    // Score a match from its outcome counts under any payoff matrix, including the SCB cost
+    ScorePair<ScoreType> scoreGame(const Strategy& p1, const Strategy& p2, const OutcomeCounts& counts,
+                                   const PayoffMatrix<ScoreType>& payoffs, const SimulationContext& context) const {
+        int rounds = static_cast<int>(std::llround(counts.total()));
+        return applyComplexityCost(p1, p2, counts.score(payoffs), rounds, context);
     }
-    
-    // Calculate mean and standard deviation from a vector of scores
-    inline ScoreStats<ScoreType> calculateStats(const std::vector<ScoreType>& scores) const {
-        ScoreStats<ScoreType> stats;
-        stats.n_samples = static_cast<int>(scores.size());
-        if (scores.empty()) return stats;
 
-        ScoreType sum = std::accumulate(scores.begin(), scores.end(), ScoreType(0));
-        stats.mean = sum / stats.n_samples;
+    // Outcome counts of `repeats` games of one pairing, resetting both match states before each game.
+    // When both strategies export a state machine, every game runs on one FSMKernel;
+    // noisy pairings with at least 64 repeats run in lockstep on the bit-sliced engine.
+    // In exact mode, memory-one pairings yield `repeats` copies of the expected counts,
+    // so their statistics have the exact mean and zero variance.
+    std::vector<OutcomeCounts> playPairingCounts(const StrategyPtr& p1, const StrategyPtr& p2,
+                                                 int rounds, int repeats, MatchHistory& history,
+                                                 const SimulationContext& context) const {
+        return playPairingCounts(p1, p2, rounds, repeats, history, context, pairingSeed(*p1, *p2), 0);
+    }
 
-        if (stats.n_samples > 1) {
-            ScoreType variance = ScoreType(0);
-            for (const ScoreType& s : scores) {
-                ScoreType diff = s - stats.mean;
-                variance += diff * diff;
+    // Same, with explicit random streams: bit-sliced block b of this call draws from
+    // mixSeed(pairing_seed, first_block + b); the scalar paths give each player a match state
+    // seeded from mixSeed(pairing_seed, first_block). p1 and p2 may be the same object.
+    std::vector<OutcomeCounts> playPairingCounts(const StrategyPtr& p1, const StrategyPtr& p2,
+                                                 int rounds, int repeats, MatchHistory& history,
+                                                 const SimulationContext& context,
+                                                 std::uint64_t pairing_seed, int first_block) const {
+        std::vector<OutcomeCounts> games;
+        games.reserve(repeats);
+
+        MemoryOneRule rule1, rule2;
+        if (exact_ && p1->getMemoryOne(rule1) && p2->getMemoryOne(rule2)) {
+            MemoryOneChain<ScoreType> chain(rule1, rule2, context.noise, context.noise, payoff_matrix_);
+            games.assign(repeats, chain.expectedCounts(rounds));
+            return games;
+        }
+
+        StrategyFSM fsm1, fsm2;
+        bool machines = p1->exportFSM(fsm1) && p2->exportFSM(fsm2);
+        if (machines) {
+            bool noisy = context.noise > 0.0;
+            if (noisy && repeats >= 64) {
+                // Seeded from the pairing, not from the match states
+                BitSlicedEngine engine(fsm1, fsm2, payoff_matrix_);
+                for (int block = 0; block * BitSlicedEngine::LANES < repeats; ++block) {
+                    int lanes = std::min(BitSlicedEngine::LANES, repeats - block * BitSlicedEngine::LANES);
+                    engine.count(rounds, context.noise, context.noise,
+                                 mixSeed(pairing_seed, first_block + block), lanes, games, context.rng);
+                }
+                return games;
             }
-            variance /= (stats.n_samples - 1);
-            stats.stdev = std::sqrt(variance);
+        }
+
+        std::uint64_t block_seed = mixSeed(pairing_seed, first_block);
+        StrategyState state1(mixSeed(block_seed, 1), context.rng);
+        StrategyState state2(mixSeed(block_seed, 2), context.rng);
 
-            ScoreType margin = ScoreType(1.96) * (stats.stdev / std::sqrt(ScoreType(stats.n_samples)));
-            stats.ci_lower = stats.mean - margin;
-            stats.ci_upper = stats.mean + margin;
+        if (machines) {
+            FSMKernel<ScoreType> kernel(fsm1, fsm2, payoff_matrix_);
+            for (int r = 0; r < repeats; ++r) {
+                games.push_back(kernel.count(*p1, *p2, state1, state2, context.noise, rounds));
+            }
+            return games;
         }
-        else {
-            stats.stdev = ScoreType(0);
-            stats.ci_lower = stats.ci_upper = stats.mean;
+
+        for (int r = 0; r < repeats; ++r) {
+            // to clean flag state
+            state1.reset();
+            state2.reset();
+            games.push_back(countGame(p1, p2, state1, state2, rounds, history, context));
         }
+        return games;
+    }
 
-        return stats;
+    // Outcome sums of the same games as playPairingCounts, taken from the result cache when
+    // it has them and stored there otherwise
+    OutcomeTensor::Cell playPairingCell(const StrategyPtr& p1, const StrategyPtr& p2,
+                                        int rounds, int repeats, MatchHistory& history,
+                                        const SimulationContext& context) const {
+        return playPairingCell(p1, p2, rounds, repeats, history, context, pairingSeed(*p1, *p2), 0);
     }
-    // Standard tournament with confidence intervals
-    // Returns a pair: first is strategy statistics results, second is match matrix (for printing)
-    std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>> 
-    runTournament(const std::vector<StrategyPtr>& strategies, int rounds, int repeats) const {
-		std::map<std::string, std::vector<ScoreType>> allScores; // collect all scores for each strategy
-        // Initialize
+
+    OutcomeTensor::Cell playPairingCell(const StrategyPtr& p1, const StrategyPtr& p2,
+                                        int rounds, int repeats, MatchHistory& history,
+                                        const SimulationContext& context,
+                                        std::uint64_t pairing_seed, int first_block) const {
+        OutcomeTensor::Cell games;
+        ResultCache::Key key;
+        if (cache_) {
+            key = cacheKey(*p1, *p2, pairing_seed, first_block, rounds, repeats, context);
+            if (cache_->find(key, games)) return games;
+        }
+        for (const OutcomeCounts& counts : playPairingCounts(p1, p2, rounds, repeats, history, context,
+                                                             pairing_seed, first_block)) {
+            games.add(counts);
+        }
+        if (cache_) cache_->insert(key, games);
+        return games;
+    }
+
+    // Score sums of both sides of a pairing's games under any payoff matrix, SCB costs included
+    std::pair<OutcomeTensor::ScoreMoments, OutcomeTensor::ScoreMoments>
+    scorePairingCell(const Strategy& p1, const Strategy& p2, const OutcomeTensor::Cell& games,
+                     const PayoffMatrix<ScoreType>& payoffs, int rounds, const SimulationContext& context) const {
+        const auto [w1, w2] = payoffWeights(payoffs);
+        double cost1 = static_cast<double>(ScoreType(context.complexityCost(p1.getComplexity(), rounds)));
+        double cost2 = static_cast<double>(ScoreType(context.complexityCost(p2.getComplexity(), rounds)));
+        return { OutcomeTensor::moments(games, w1, cost1), OutcomeTensor::moments(games, w2, cost2) };
+    }
+
+    // Play one pairing `repeats` times and score each game with this simulator's payoffs
+    std::vector<ScorePair<ScoreType>> playPairing(const StrategyPtr& p1, const StrategyPtr& p2,
+                                                  int rounds, int repeats, MatchHistory& history) const {
+        return playPairing(p1, p2, rounds, repeats, history, context_);
+    }
+
+    // Same, with explicit noise and SCB settings
+    std::vector<ScorePair<ScoreType>> playPairing(const StrategyPtr& p1, const StrategyPtr& p2,
+                                                  int rounds, int repeats, MatchHistory& history,
+                                                  const SimulationContext& context) const {
+        std::vector<ScorePair<ScoreType>> games;
+        games.reserve(repeats);
+        for (const OutcomeCounts& counts : playPairingCounts(p1, p2, rounds, repeats, history, context)) {
+            games.push_back(scoreGame(*p1, *p2, counts, payoff_matrix_, context));
+        }
+        return games;
+    }
+    
+    // Payoff of each outcome code for player 1 and player 2, as doubles for OutcomeTensor::moments
+    static std::pair<std::array<double, 4>, std::array<double, 4>> payoffWeights(const PayoffMatrix<ScoreType>& payoffs) {
+        auto [payoff1, payoff2] = OutcomeCounts::payoffVectors(payoffs);
+        std::array<double, 4> w1, w2;
+        for (int c = 0; c < 4; ++c) {
+            w1[c] = static_cast<double>(payoff1[c]);
+            w2[c] = static_cast<double>(payoff2[c]);
+        }
+        return { w1, w2 };
+    }
+
+    // Calculate mean and standard deviation from a vector of scores, in one pass
+    inline ScoreStats<ScoreType> calculateStats(const std::vector<ScoreType>& scores) const {
+        OutcomeTensor::ScoreMoments moments;
+        for (const ScoreType& s : scores) moments.add(static_cast<double>(s));
+        return ScoreStats<ScoreType>::fromMoments(moments);
+    }
+
+    // Stats from accumulated scores, with the same formulas as calculateStats
+    ScoreStats<ScoreType> statsFromMoments(const OutcomeTensor::ScoreMoments& m) const {
+        return ScoreStats<ScoreType>::fromMoments(m);
+    }
+
+    // Play a round-robin tournament and keep only the outcome counts of every game.
+    // The pairings i <= j are cut into square tiles of up to PAIR_TILE strategies, and a
+    // task plays every pairing of one tile for one block of repeats; nothing is stored per
+    // pairing besides the tensor itself. Tasks share the immutable strategies and play on
+    // their own match states, seeded from --seed, the two strategies and the block (see
+    // playTournamentCell), and the blocks of a pairing are merged in block order, so
+    // results are identical for any number of threads and any order of the strategies.
+    OutcomeTensor runTournamentOutcomes(const std::vector<StrategyPtr>& strategies, int rounds, int repeats) const {
+        return runTournamentOutcomes(strategies, rounds, repeats, context_);
+    }
+
+    // Same, with explicit noise and SCB settings. Safe to call concurrently with other contexts.
+    OutcomeTensor runTournamentOutcomes(const std::vector<StrategyPtr>& strategies, int rounds, int repeats,
+                                        const SimulationContext& context) const {
+        std::vector<std::string> names, ids;
+        std::vector<double> costs;
         for (const auto& s : strategies) {
-            allScores[s->getName()] = std::vector<ScoreType>();
-        }
-
-        // Store detailed match results for table display
-        int N = static_cast<int>(strategies.size());
-        std::vector<std::vector<ScorePair<ScoreType>>> matchResults(N, std::vector<ScorePair<ScoreType>>(N));
-
-        // Round-robin: Every strategy plays against every other strategy
-        for (size_t i = 0; i < strategies.size(); ++i) {
-            for (size_t j = i; j < strategies.size(); ++j) {
-                const auto& p1 = strategies[i];
-                const StrategyPtr* p2_ptr;
-				// when i==j, play with a clone of itself, to avoid state interference
-                std::unique_ptr<Strategy> p2_clone;
-
-                if (i == j)
-                {
-                    p2_clone = p1->clone();
-                    // Important: Set a new random seed for the clone to ensure different random number sequences
-                    p2_clone->setSeed(std::random_device{}());
-                    p2_ptr = &p2_clone;
+            names.push_back(s->getName());
+            ids.push_back(s->cacheId());
+            costs.push_back(static_cast<double>(ScoreType(context.complexityCost(s->getComplexity(), rounds))));
+        }
+        OutcomeTensor tensor(names, costs);
+        if (keep_games_) tensor.keepGames();
+
+        // Round-robin: Every strategy plays against every other strategy (and itself).
+        // Smaller tiles for small tournaments, so there are enough tasks for the pool.
+        const int N = static_cast<int>(strategies.size());
+        const int blocks = repeats > 0 ? (repeats + REPEAT_BLOCK - 1) / REPEAT_BLOCK : 0;
+        const std::size_t wanted = 4 * static_cast<std::size_t>(pool_->size());
+        int edge = PAIR_TILE;
+        auto tileCount = [N](int side) {
+            std::size_t per_side = (N + side - 1) / side;
+            return per_side * (per_side + 1) / 2;
+        };
+        while (edge > 1 && tileCount(edge) < wanted) edge /= 2;
+
+        std::vector<std::pair<int, int>> tiles; // (first row, first column), column >= row
+        for (int row = 0; row < N; row += edge) {
+            for (int column = row; column < N; column += edge) tiles.push_back({ row, column });
+        }
+
+        // Play every pairing of a tile for one block, handing each cell and its kept games
+        // (empty unless keep_games_) to store(i, j, cell, games)
+        auto playTile = [&](const std::pair<int, int>& tile, int block, auto&& store) {
+            const int block_repeats = std::min(REPEAT_BLOCK, repeats - block * REPEAT_BLOCK);
+            MatchHistory history;
+            std::vector<OutcomeCounts> games;
+            for (int i = tile.first; i < std::min(N, tile.first + edge); ++i) {
+                for (int j = std::max(i, tile.second); j < std::min(N, tile.second + edge); ++j) {
+                    games.clear();
+                    store(i, j, playTournamentCell(strategies, ids, i, j, rounds, block_repeats, history, context,
+                                                   block, keep_games_ ? &games : nullptr), games);
+                }
+            }
+        };
+
+        // Blocks run in waves so that small tournaments still fill the pool. The first block
+        // of a wave merges straight into the tensor; the others wait in per-tile buffers and
+        // are merged in block order once the wave is done. Large tournaments have enough
+        // tiles for waves of one block, so they never hold more than the tensor.
+        const int wave = static_cast<int>(std::max<std::size_t>(1, (wanted + tiles.size() - 1) / std::max<std::size_t>(1, tiles.size())));
+        std::vector<std::vector<OutcomeTensor::Cell>> pending;
+        std::vector<std::vector<std::vector<OutcomeCounts>>> pending_games; // only with keep_games_
+        for (int first = 0; first < blocks; first += wave) {
+            const int count = std::min(wave, blocks - first);
+            pending.assign(tiles.size() * (count - 1), {});
+            pending_games.assign(keep_games_ ? pending.size() : 0, {});
+            pool_->parallelFor(tiles.size() * count, [&](std::size_t t) {
+                const std::size_t tile = t % tiles.size(), offset = t / tiles.size();
+                if (offset == 0) {
+                    playTile(tiles[tile], first, [&](int i, int j, const OutcomeTensor::Cell& cell,
+                                                     const std::vector<OutcomeCounts>& games) {
+                        tensor.merge(i, j, cell);
+                        if (keep_games_) tensor.appendGames(i, j, games);
+                    });
                 }
-                else
-                {
-					p2_ptr = &strategies[j];
+                else {
+                    const std::size_t b = (offset - 1) * tiles.size() + tile;
+                    playTile(tiles[tile], first + static_cast<int>(offset), [&](int, int, const OutcomeTensor::Cell& cell,
+                                                                                const std::vector<OutcomeCounts>& games) {
+                        pending[b].push_back(cell);
+                        if (keep_games_) pending_games[b].push_back(games);
+                    });
                 }
-                const auto& p2 = *p2_ptr;
-                std::vector<ScoreType> p1_scores;
-                std::vector<ScoreType> p2_scores;
-
-                for (int r = 0; r < repeats; ++r) {
-                    // to clean flag state
-                    p1.get()->reset();
-                    p2.get()->reset();
-
-                    ScorePair<ScoreType> scores = runGame(p1, p2, rounds);
-                    p1_scores.push_back(scores.first);
-                    p2_scores.push_back(scores.second);
-                    
-                    // Fix: When a strategy plays itself (i==j), only add score once
-                    if (i == j) {
-                        // Same strategy playing itself, both scores are the same, only add once
-                        allScores[p1->getName()].push_back(scores.first);
-                    } else {
-                        // Different strategies playing, add each score separately
-                        allScores[p1->getName()].push_back(scores.first);
-                        allScores[p2->getName()].push_back(scores.second);
+            });
+            for (std::size_t b = 0; b < pending.size(); ++b) {
+                const auto& tile = tiles[b % tiles.size()];
+                std::size_t cell = 0;
+                for (int i = tile.first; i < std::min(N, tile.first + edge); ++i) {
+                    for (int j = std::max(i, tile.second); j < std::min(N, tile.second + edge); ++j) {
+                        if (keep_games_) tensor.appendGames(i, j, pending_games[b][cell]);
+                        tensor.merge(i, j, pending[b][cell++]);
                     }
                 }
+            }
+        }
+
+        if (ci_target_ > 0.0) {
+            extendToTarget(tensor, strategies, ids, rounds, blocks, context);
+            tensor.setPairingWeight(std::max(1, repeats));
+        }
+        return tensor;
+    }
+
+    // Adaptive repeats: every pairing still short of the CI target gets another block of
+    // games, sized from its current variance (1.96 s / target)^2 and at most REPEAT_BLOCK,
+    // until all pairings are done. Extension k of a pairing draws from block
+    // first_block + k of its random stream, so results do not depend on the threads.
+    void extendToTarget(OutcomeTensor& tensor, const std::vector<StrategyPtr>& strategies,
+                        const std::vector<std::string>& ids, int rounds,
+                        int first_block, const SimulationContext& context) const {
+        const auto weights = payoffWeights(payoff_matrix_);
+
+        // Games pairing (i, j) should still play: 0 once it meets the target or the cap
+        auto shortfall = [&](int i, int j) -> int {
+            const OutcomeTensor::Cell& cell = tensor.cell(i, j);
+            const int left = max_repeats_ - cell.games;
+            if (left <= 0) return 0;
+            if (cell.games < 2) return std::min(left, 2 - cell.games); // no spread from one game
+            if (pairingHalfWidth(tensor, i, j, weights) <= ci_target_) return 0;
+            ScoreStats<ScoreType> s1 = statsFromMoments(OutcomeTensor::moments(cell, weights.first, tensor.gameCost(i)));
+            ScoreStats<ScoreType> s2 = statsFromMoments(OutcomeTensor::moments(cell, weights.second, tensor.gameCost(j)));
+            double spread = std::max(static_cast<double>(s1.stdev), static_cast<double>(s2.stdev));
+            double needed = std::ceil(std::pow(1.96 * spread / ci_target_, 2)) - cell.games;
+            return static_cast<int>(std::min<double>(left, std::max(1.0, needed)));
+        };
+
+        std::vector<std::pair<int, int>> active;
+        for (int i = 0; i < tensor.size(); ++i) {
+            for (int j = i; j < tensor.size(); ++j) active.push_back({ i, j });
+        }
+        std::vector<int> sizes;
+        for (int block = first_block; ; ++block) {
+            std::vector<std::pair<int, int>> next;
+            sizes.clear();
+            for (const auto& [i, j] : active) {
+                int more = shortfall(i, j);
+                if (more > 0) {
+                    next.push_back({ i, j });
+                    sizes.push_back(std::min(more, REPEAT_BLOCK));
+                }
+            }
+            if (next.empty()) break;
+            active.swap(next);
+
+            // Distinct pairings, so the merges do not overlap
+            pool_->parallelFor(active.size(), [&](std::size_t p) {
+                const int i = active[p].first, j = active[p].second;
+                MatchHistory history;
+                std::vector<OutcomeCounts> games;
+                tensor.merge(i, j, playTournamentCell(strategies, ids, i, j, rounds, sizes[p], history, context,
+                                                      block, keep_games_ ? &games : nullptr));
+                if (keep_games_) tensor.appendGames(i, j, games);
+            });
+        }
+    }
 
-                // Calculate average for match table
-                ScoreType avg_score1 = ScoreType(0), avg_score2 = ScoreType(0);
-                for (const ScoreType& s : p1_scores) avg_score1 += s;
-                for (const ScoreType& s : p2_scores) avg_score2 += s;
-                avg_score1 /= repeats;
-                avg_score2 /= repeats;
+    // Larger of the two 95% CI half-widths of pairing (i, j), i <= j, under this simulator's payoffs
+    double pairingHalfWidth(const OutcomeTensor& tensor, int i, int j) const {
+        return pairingHalfWidth(tensor, i, j, payoffWeights(payoff_matrix_));
+    }
+
+    double pairingHalfWidth(const OutcomeTensor& tensor, int i, int j,
+                            const std::pair<std::array<double, 4>, std::array<double, 4>>& weights) const {
+        const OutcomeTensor::Cell& cell = tensor.cell(i, j);
+        ScoreStats<ScoreType> s1 = statsFromMoments(OutcomeTensor::moments(cell, weights.first, tensor.gameCost(i)));
+        ScoreStats<ScoreType> s2 = statsFromMoments(OutcomeTensor::moments(cell, weights.second, tensor.gameCost(j)));
+        return std::max(static_cast<double>(s1.ci_upper - s1.mean), static_cast<double>(s2.ci_upper - s2.mean));
+    }
 
-                matchResults[i][j] = { avg_score1, avg_score2 };
+    // Strategy statistics of a recorded tournament under any payoff matrix, without the
+    // match matrix. Totals are kept per strategy index and keyed by name at the end.
+    // With a pairing weight (adaptive repeats) every pairing counts equally in the mean and
+    // the stdev, but the CI comes from the games actually played: the mean over K pairings
+    // has variance sum_k s_k^2 / n_k / K^2, so extra games narrow it. That CI leaves out the
+    // spread between pairings, which stdev / sqrt(N) of fixed repeats includes, so such
+    // stats are marked stratified_ci and labelled apart in the output.
+    std::map<std::string, ScoreStats<ScoreType>> scoreTournament(const OutcomeTensor& tensor,
+                                                                 const PayoffMatrix<ScoreType>& payoffs) const {
+        const auto [w1, w2] = payoffWeights(payoffs);
+        const int N = tensor.size();
+        const bool weighted = tensor.pairingWeight() > 0;
+        std::vector<OutcomeTensor::ScoreMoments> totals(N); // all games of each strategy
+        std::vector<double> mean_variance(N, 0.0);           // sum of s_k^2 / n_k over its pairings
+        std::vector<int> pairings(N, 0);
+        for (int i = 0; i < N; ++i) {
+            for (int j = i; j < N; ++j) {
+                const OutcomeTensor::Cell& cell = tensor.cell(i, j);
+                if (cell.games == 0) continue;
+
+                // A strategy playing itself only counts its own side once
+                OutcomeTensor::ScoreMoments m1 = OutcomeTensor::moments(cell, w1, tensor.gameCost(i));
+                OutcomeTensor::ScoreMoments m2 = OutcomeTensor::moments(cell, w2, tensor.gameCost(j));
+                if (weighted) {
+                    mean_variance[i] += m1.variance() / m1.games;
+                    ++pairings[i];
+                    if (i != j) {
+                        mean_variance[j] += m2.variance() / m2.games;
+                        ++pairings[j];
+                    }
+                    m1 = m1.reweighted(tensor.pairingWeight());
+                    m2 = m2.reweighted(tensor.pairingWeight());
+                }
+                totals[i] += m1;
                 if (i != j) {
-                    matchResults[j][i] = { avg_score2, avg_score1 };
+                    totals[j] += m2;
                 }
             }
         }
 
-        // Calculate overall statistics for each strategy (including confidence intervals)
+        // Calculate overall statistics for each strategy (including confidence intervals);
+        // strategies sharing a name are pooled
+        std::map<std::string, OutcomeTensor::ScoreMoments> by_name;
+        std::map<std::string, std::pair<double, int>> error_by_name;
+        for (int i = 0; i < N; ++i) {
+            by_name[tensor.name(i)] += totals[i];
+            auto& error = error_by_name[tensor.name(i)];
+            error.first += mean_variance[i];
+            error.second += pairings[i];
+        }
         std::map<std::string, ScoreStats<ScoreType>> stats;
-        for (const auto& [name, scores] : allScores) {
-            stats[name] = calculateStats(scores);
+        for (const auto& [name, moments] : by_name) {
+            ScoreStats<ScoreType> s = statsFromMoments(moments);
+            const auto& error = error_by_name[name];
+            if (weighted && error.second > 0) {
+                double margin = 1.96 * std::sqrt(error.first) / error.second;
+                s.ci_lower = ScoreType(moments.mean - margin);
+                s.ci_upper = ScoreType(moments.mean + margin);
+                s.stratified_ci = true;
+            }
+            stats[name] = s;
+        }
+        return stats;
+    }
+
+    // Stream the match matrix of a recorded tournament one row at a time: row(i, scores)
+    // gets scores[j] = (average score of i, average score of j) over their games. Only one
+    // row is held in memory.
+    template<typename RowSink>
+    void forEachMatchRow(const OutcomeTensor& tensor, const PayoffMatrix<ScoreType>& payoffs, RowSink&& row) const {
+        const auto [w1, w2] = payoffWeights(payoffs);
+        const int N = tensor.size();
+        std::vector<ScorePair<ScoreType>> scores(N);
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                // Pairings are stored once, from the side of the lower index
+                const bool upper = i <= j;
+                const OutcomeTensor::Cell& cell = upper ? tensor.cell(i, j) : tensor.cell(j, i);
+                if (cell.games == 0) {
+                    scores[j] = {};
+                    continue;
+                }
+                OutcomeTensor::ScoreMoments m1 = OutcomeTensor::moments(cell, w1, tensor.gameCost(upper ? i : j));
+                OutcomeTensor::ScoreMoments m2 = OutcomeTensor::moments(cell, w2, tensor.gameCost(upper ? j : i));
+                ScoreType avg_score1 = ScoreType(m1.mean);
+                ScoreType avg_score2 = ScoreType(m2.mean);
+                scores[j] = upper ? ScorePair<ScoreType>{ avg_score1, avg_score2 }
+                                  : ScorePair<ScoreType>{ avg_score2, avg_score1 };
+            }
+            row(i, scores);
+        }
+    }
+
+    // Score a recorded tournament under any payoff matrix
+    // Returns the same pair as runTournament: strategy statistics and the match matrix
+    std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>>
+    rescoreTournament(const OutcomeTensor& tensor, const PayoffMatrix<ScoreType>& payoffs) const {
+        std::vector<std::vector<ScorePair<ScoreType>>> matchResults(tensor.size());
+        forEachMatchRow(tensor, payoffs, [&](int i, const std::vector<ScorePair<ScoreType>>& scores) {
+            matchResults[i] = scores;
+        });
+        return { scoreTournament(tensor, payoffs), matchResults };
+    }
+
+    // Standard tournament with confidence intervals
+    // Returns a pair: first is strategy statistics results, second is match matrix (for printing)
+    std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>> 
+    runTournament(const std::vector<StrategyPtr>& strategies, int rounds, int repeats) const {
+        return runTournament(strategies, rounds, repeats, context_);
+    }
+
+    // Same, with explicit noise and SCB settings
+    std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>> 
+    runTournament(const std::vector<StrategyPtr>& strategies, int rounds, int repeats,
+                  const SimulationContext& context) const {
+        return rescoreTournament(runTournamentOutcomes(strategies, rounds, repeats, context), payoff_matrix_);
+    }
+
+    // Raw samples of a tournament played with setKeepGames(true): every game score of each
+    // strategy under this simulator's payoffs, SCB costs included, pairing by pairing and
+    // game by game in block order, so for any number of threads. A strategy playing itself
+    // only counts its own side once, as in scoreTournament.
+    std::map<std::string, std::vector<ScoreType>> gameScores(const OutcomeTensor& tensor) const {
+        std::map<std::string, std::vector<ScoreType>> scores;
+        for (int i = 0; i < tensor.size(); ++i) scores[tensor.name(i)];
+        if (!tensor.keepsGames()) return scores;
+        for (int i = 0; i < tensor.size(); ++i) {
+            for (int j = i; j < tensor.size(); ++j) {
+                auto& own = scores.at(tensor.name(i));
+                auto& other = scores.at(tensor.name(j));
+                for (const OutcomeCounts& counts : tensor.games(i, j)) {
+                    const auto [score1, score2] = counts.score(payoff_matrix_);
+                    own.push_back(score1 - ScoreType(tensor.gameCost(i)));
+                    if (i != j) other.push_back(score2 - ScoreType(tensor.gameCost(j)));
+                }
+            }
         }
-        
-        return { stats, matchResults };
+        return scores;
     }
 
 
+    // Payoff grid: re-score one recorded tournament under every T/R/P/S combination.
+    // Combinations that are not a valid Prisoner's Dilemma are skipped.
+    std::vector<PayoffGridPoint<ScoreType>> rescorePayoffGrid(
+        const OutcomeTensor& tensor,
+        const std::vector<ScoreType>& t_values, const std::vector<ScoreType>& r_values,
+        const std::vector<ScoreType>& p_values, const std::vector<ScoreType>& s_values) const {
+        std::vector<PayoffGridPoint<ScoreType>> grid;
+        for (ScoreType T : t_values) {
+            for (ScoreType R : r_values) {
+                for (ScoreType P : p_values) {
+                    for (ScoreType S : s_values) {
+                        PayoffMatrix<ScoreType> payoffs;
+                        try {
+                            payoffs = PayoffMatrix<ScoreType>(T, R, P, S);
+                        }
+                        catch (const std::invalid_argument&) {
+                            continue;
+                        }
+                        grid.push_back({ payoffs, rescoreTournament(tensor, payoffs).first });
+                    }
+                }
+            }
+        }
+        return grid;
+    }
+
+    // Tournaments at several noise levels, all run concurrently: one task group per level on
+    // the shared thread pool, each level's tournament splitting further into its own tasks.
+    // Entry k holds the results for noise_levels[k]; they match running the levels one by one.
+    std::vector<std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>>>
+    runTournamentSweep(const std::vector<StrategyPtr>& strategies, int rounds, int repeats,
+                       const std::vector<double>& noise_levels) const {
+        std::vector<std::pair<std::map<std::string, ScoreStats<ScoreType>>, std::vector<std::vector<ScorePair<ScoreType>>>>>
+            levels(noise_levels.size());
+        pool_->parallelFor(noise_levels.size(), [&](std::size_t k) {
+            levels[k] = runTournament(strategies, rounds, repeats, context_.withNoise(noise_levels[k]));
+        });
+        return levels;
+    }
+
     // Noise Sweep: Run tournaments at different noise levels
+    // All levels are simulated first (see runTournamentSweep), then printed in order.
     std::map<double, std::map<std::string, ScoreStats<ScoreType>>> runNoiseSweep(
         std::vector<StrategyPtr>& strategies,
         int rounds,
@@ -232,12 +982,12 @@ public:
         std::cout << "       Noise Sweep Experiment\n";
         std::cout << "=================================================\n\n";
 
-        for (double epsilon : noise_levels) {
+        auto levels = runTournamentSweep(strategies, rounds, repeats, noise_levels);
+        for (std::size_t k = 0; k < noise_levels.size(); ++k) {
+            double epsilon = noise_levels[k];
             std::cout << "\n--- Testing noise level  = " << std::fixed << std::setprecision(2)
                 << epsilon << " ---\n";
-			Strategy::setNoise(epsilon); // Set static noise level
-            // Run the tournament
-            auto [tournamentResults, matchResults] = runTournament(strategies, rounds, repeats);
+            const auto& tournamentResults = levels[k].first;
             results[epsilon] = tournamentResults;
 
             // Print results for this noise level
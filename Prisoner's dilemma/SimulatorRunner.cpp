@@ -10,10 +10,26 @@
 #include <sstream>
 #include <chrono>
 #include <iomanip>
+#include <cmath>
+#include <tuple>
+#include <optional>
 
 // Constructor initializes the simulator with payoffs from the configuration.
 SimulatorRunner::SimulatorRunner(const Config& config)
     : config_(config), simulator_(config.payoffs, config.epsilon), printer_(config) {
+    SimulationContext context;
+    context.noise = config.epsilon;
+    context.enable_scb = config.enable_scb;          // SCB: Apply complexity budget configuration
+    context.scb_cost_factor = config.scb_cost_factor;
+    context.rng = parseRngKind(config.rng);
+    simulator_.setContext(context);
+    simulator_.setSeed(config.seed);
+    simulator_.setExact(config.exact);
+    simulator_.setCITarget(config.ci_target, config.max_repeats);
+    simulator_.setThreads(static_cast<unsigned>(std::max(0, config.threads)));
+    if (!config.cache.empty()) {
+        simulator_.setCache(std::make_shared<ResultCache>(config.cache));
+    }
 }
 
 // Helper function to generate output filename with timestamp
@@ -49,6 +65,16 @@ std::string SimulatorRunner::generateOutputFilename(const std::string& prefix, c
 
 // Main execution flow
 void SimulatorRunner::run() {
+    runExperiment();
+
+    if (const ResultCache* cache = simulator_.getCache()) {
+        std::cout << "\nResult cache " << cache->path() << ": " << cache->hits() << " pairing blocks reused, "
+                  << cache->misses() << " simulated\n";
+    }
+}
+
+// Run the mode selected by the configuration
+void SimulatorRunner::runExperiment() {
     setupStrategies();
     printer_.printConfiguration(strategies_);
     printer_.printPayoffMatrix();
@@ -58,6 +84,48 @@ void SimulatorRunner::run() {
         printer_.printComplexityTable(strategies_);
     }
     
+    // Benchmark mode: measure engine throughput only
+    if (config_.benchmark) {
+        runBenchmark();
+        return;
+    }
+    
+    // Payoff grid mode: simulate once, re-score under every payoff matrix
+    if (config_.payoff_grid) {
+        runPayoffGrid();
+        return;
+    }
+    
+    // Genetic search mode: evolve lookup-table strategies against the field
+    if (config_.optimize) {
+        runOptimize();
+        return;
+    }
+    
+    // Island model: parallel sub-populations with migration (replicator or finite dynamics)
+    if (config_.islands > 0) {
+        runIslands();
+        return;
+    }
+    
+    // Finite population mode: fixation probabilities of single mutants
+    if (!config_.finite.empty()) {
+        runFixation();
+        return;
+    }
+    
+    // Spatial lattice mode: strategies on a torus imitating their neighbors
+    if (config_.lattice > 0) {
+        runLattice();
+        return;
+    }
+    
+    // Graph evolution mode: strategies on the nodes of a network
+    if (!config_.graph.empty()) {
+        runGraphEvolution();
+        return;
+    }
+    
     // Q5: SCB Comparison Mode
     if (config_.scb_compare) {
         runSCBComparison();
@@ -102,6 +170,11 @@ std::unique_ptr<Strategy> SimulatorRunner::createStrategy(const std::string& nam
     if (name == "PAVLOV") return std::make_unique<PAVLOV>();
     if (name == "ContriteTitForTat") return std::make_unique<ContriteTitForTat>();
     if (name == "PROBER") return std::make_unique<PROBER>();
+    if (name == "MemoryTwo") return std::make_unique<MemoryTwo>();
+    if (name == "SoftGrudger") return std::make_unique<SoftGrudger>();
+
+    // Lookup-table families, e.g. M1:1,0,0,1 (win-stay lose-shift) or LT1:3 (TFT); see LookupTableStrategy
+    if (LookupTableStrategy::isSpec(name)) return LookupTableStrategy::parse(name);
     
     // Parse RandomStrategy parameters, format: RandomStrategy<prob>
     // Example: RandomStrategy0.3 means prob=0.3
@@ -132,17 +205,11 @@ std::unique_ptr<Strategy> SimulatorRunner::createStrategy(const std::string& nam
 
 // Set up the strategies to use in the tournament.
 void SimulatorRunner::setupStrategies() {
-    Strategy::setNoise(config_.epsilon);
-    // SCB: Apply complexity budget configuration
-    Strategy::enableSCB(config_.enable_scb);
-    Strategy::setSCBCostFactor(config_.scb_cost_factor);
-    
     for (const auto& name : config_.strategy_names) {
         auto strat = createStrategy(name);
         if (!strat) {
             throw std::runtime_error("Unknown strategy found: " + name);
         }
-        strat->setSeed(config_.seed);
         strategies_.push_back(std::move(strat));
     }
 
@@ -153,11 +220,46 @@ void SimulatorRunner::setupStrategies() {
 
 void SimulatorRunner::runSimulation() {
     std::cout << "\n--- Tournament Start ---\n";
-    auto [stats, matchResults] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats);
-    results_ = stats;
+    simulator_.setKeepGames(!config_.samples.empty());
+    OutcomeTensor tensor = simulator_.runTournamentOutcomes(strategies_, config_.rounds, config_.repeats);
+    simulator_.setKeepGames(false);
+    const auto& payoffs = simulator_.getPayoffMatrix();
+    results_ = simulator_.scoreTournament(tensor, payoffs);
     
-    // Print match matrix
-    printer_.printMatchTable(strategies_, matchResults);
+    // Print match matrix; large ones are only streamed to --match-matrix
+    if (strategies_.size() <= MATCH_TABLE_LIMIT) {
+        printer_.printMatchTable(strategies_, simulator_.rescoreTournament(tensor, payoffs).second);
+    }
+    else {
+        std::cout << "\nMatch matrix of " << strategies_.size() << " strategies not printed"
+                  << (config_.match_matrix.empty() ? " (use --match-matrix to write it to a file)" : "") << ".\n";
+    }
+
+    if (!config_.match_matrix.empty()) {
+        OutputExporter::MatchMatrixWriter writer(config_.match_matrix, strategies_);
+        simulator_.forEachMatchRow(tensor, payoffs, [&](int i, const std::vector<std::pair<double, double>>& scores) {
+            writer.writeRow(strategies_[i]->getName(), scores);
+        });
+        writer.close();
+    }
+
+    // Adaptive repeats: games each pairing actually needed
+    if (config_.ci_target > 0.0) {
+        std::vector<int> games;
+        std::vector<double> half_widths;
+        for (int i = 0; i < tensor.size(); ++i) {
+            for (int j = i; j < tensor.size(); ++j) {
+                games.push_back(tensor.cell(i, j).games);
+                half_widths.push_back(simulator_.pairingHalfWidth(tensor, i, j));
+            }
+        }
+        printer_.printRepeatsSpent(strategies_, games, half_widths, strategies_.size() <= MATCH_TABLE_LIMIT);
+    }
+
+    // Raw samples: every game the tournament kept, as played
+    if (!config_.samples.empty()) {
+        OutputExporter::exportSamplesCSV(simulator_.gameScores(tensor), config_.samples);
+    }
 }
 
 void SimulatorRunner::runExploiter() {
@@ -174,41 +276,26 @@ void SimulatorRunner::runExploiter() {
     }
     std::cout << "\n\n";
 
-    // Store scores for all strategies
-    std::map<std::string, std::vector<double>> allScores;
-    allScores[exploiter_name] = std::vector<double>();
+    // Score sums of all strategies, pooled over their matches
+    std::map<std::string, OutcomeTensor::ScoreMoments> allScores;
+    allScores[exploiter_name] = OutcomeTensor::ScoreMoments();
 
     std::map<std::string, std::pair<double, double>> matchAverages;
-
-    // Initialize score vectors for each victim
-    for (size_t i = 1; i < strategies_.size(); ++i) {
-        allScores[strategies_[i]->getName()] = std::vector<double>();
-    }
+    MatchHistory history;
+    const SimulationContext& context = simulator_.getContext();
 
     for (size_t i = 1; i < strategies_.size(); ++i) {
         const auto& victim = strategies_[i];
         std::string victim_name = victim->getName();
-        std::vector<double> exploiter_scores_this_match;
-        std::vector<double> victim_scores_this_match;
-
-        for (int r = 0; r < config_.repeats; ++r) {
-            exploiter->reset();
-            victim->reset();
 
-            auto scores = simulator_.runGame(exploiter, victim, config_.rounds);
+        // Outcome sums of all repeats, from the result cache if it has them
+        OutcomeTensor::Cell games = simulator_.playPairingCell(exploiter, victim, config_.rounds, config_.repeats, history, context);
+        auto [exploiter_scores, victim_scores] = simulator_.scorePairingCell(*exploiter, *victim, games,
+                                                                            simulator_.getPayoffMatrix(), config_.rounds, context);
+        allScores[exploiter_name] += exploiter_scores;
+        allScores[victim_name] += victim_scores;
 
-            allScores[exploiter_name].push_back(scores.first);
-            allScores[victim_name].push_back(scores.second);
-
-            exploiter_scores_this_match.push_back(scores.first);
-            victim_scores_this_match.push_back(scores.second);
-        }
-        
-        double exploiter_avg = std::accumulate(exploiter_scores_this_match.begin(),
-            exploiter_scores_this_match.end(), 0.0) / config_.repeats;
-        double victim_avg = std::accumulate(victim_scores_this_match.begin(),
-            victim_scores_this_match.end(), 0.0) / config_.repeats;
-        matchAverages[victim_name] = { exploiter_avg, victim_avg };
+        matchAverages[victim_name] = { exploiter_scores.mean, victim_scores.mean };
     }
     
     // Use ResultsPrinter to print
@@ -216,7 +303,7 @@ void SimulatorRunner::runExploiter() {
 
     results_.clear();
     for (const auto& [name, scores] : allScores) {
-        results_[name] = simulator_.calculateStats(scores);
+        results_[name] = simulator_.statsFromMoments(scores);
     }
     std::cout << "\n--- All exploiter matches completed ---\n";
 }
@@ -259,26 +346,50 @@ void SimulatorRunner::runEvolution() {
 
 std::vector<std::map<std::string, double>>
 SimulatorRunner::runSingleEvolution(double noise, const std::string& label) {
-    Strategy::setNoise(noise);
+    SimulationContext context = simulator_.getContext().withNoise(noise);
 
-    std::map<std::string, double> populations;
-    double initial_fraction = 1.0 / strategies_.size();
-    for (const auto& s : strategies_) {
-        populations[s->getName()] = initial_fraction;
+    // Pairwise scores do not depend on the population shares: estimate them once
+    // (or every payoff_refresh generations) and reuse them for every generation
+    auto payoffs = estimatePayoffMatrix(context, 0);
+
+    ReplicatorSolver::Options options = replicatorOptions();
+    std::vector<double> shares(strategies_.size(), 1.0 / strategies_.size());
+    ReplicatorSolver::Result result;
+    if (config_.payoff_refresh <= 0) {
+        result = ReplicatorSolver(payoffs, options).run(shares, config_.generations);
     }
-    
+    else {
+        // The matrix changes at every refresh, so the shares need not settle:
+        // run each refresh period in full and join the trajectories
+        options.tolerance = 0.0;
+        if (config_.generations > 0) result.trajectory.push_back(shares);
+        for (int start = 0; start < config_.generations - 1; start += config_.payoff_refresh) {
+            if (start > 0) {
+                payoffs = estimatePayoffMatrix(context, start / config_.payoff_refresh);
+            }
+            int span = std::min(config_.payoff_refresh, config_.generations - 1 - start);
+            auto segment = ReplicatorSolver(payoffs, options).run(shares, span + 1);
+            result.trajectory.insert(result.trajectory.end(), segment.trajectory.begin() + 1, segment.trajectory.end());
+            result.stalled = result.stalled || segment.stalled;
+            shares = result.trajectory.back();
+        }
+    }
+    if (result.stalled) {
+        std::cerr << "Warning: Average fitness is too low, skipping update.\n";
+    }
+
     std::vector<std::map<std::string, double>> history;
-    for (int gen = 0; gen < config_.generations; gen++) {
-        history.push_back(populations);
-        
-        // Print real-time population changes (SCB-aware)
-        printer_.printSCBEvolutionProgress(gen, populations, strategies_, Strategy::isSCBEnabled());
-        
-        if (gen == config_.generations - 1) break;
+    for (const auto& generation : result.trajectory) {
+        std::map<std::string, double> populations;
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            populations[strategies_[i]->getName()] = generation[i];
+        }
 
-        auto fitness = calculateFitness(populations, config_.rounds, config_.repeats);
-        updatePopulations(populations, fitness);
+        // Print real-time population changes (SCB-aware)
+        printer_.printSCBEvolutionProgress(static_cast<int>(history.size()), populations, strategies_, context.enable_scb);
+        history.push_back(std::move(populations));
     }
+    printer_.printReplicatorConvergence(result.converged_at, result.period);
     
     // Print history after all generations are complete
     printer_.printEvolutionHistory(history, strategies_, label);
@@ -286,92 +397,457 @@ SimulatorRunner::runSingleEvolution(double noise, const std::string& label) {
     return history;
 }
 
-std::map<std::string, double> SimulatorRunner::calculateFitness(
-    const std::map<std::string, double>& populations, int rounds, int repeats) {
+// Average score of strategy i against strategy j (payoffs[i][j]), from one round-robin tournament.
+// Each refresh re-estimates the matrix from a fresh random stream.
+std::vector<std::vector<double>> SimulatorRunner::estimatePayoffMatrix(const SimulationContext& context, int refresh) {
+    DefaultSimulator estimator = simulator_;
+    if (refresh > 0) {
+        estimator.setSeed(mixSeed(config_.seed, refresh));
+    }
+    OutcomeTensor tensor = estimator.runTournamentOutcomes(strategies_, config_.rounds, config_.repeats, context);
+
+    // Filled row by row from the tensor, without an intermediate match matrix
+    std::vector<std::vector<double>> payoffs(strategies_.size(), std::vector<double>(strategies_.size()));
+    estimator.forEachMatchRow(tensor, estimator.getPayoffMatrix(), [&](int i, const std::vector<std::pair<double, double>>& scores) {
+        for (size_t j = 0; j < strategies_.size(); ++j) {
+            payoffs[i][j] = scores[j].first;
+        }
+    });
+    return payoffs;
+}
+
+// Replicator solver settings of the evolution runs
+ReplicatorSolver::Options SimulatorRunner::replicatorOptions() const {
+    ReplicatorSolver::Options options;
+    options.method = parseReplicatorMethod(config_.replicator);
+    options.tolerance = config_.convergence_tol;
+    options.pool = &simulator_.getThreadPool();
+    return options;
+}
 
-    std::map<std::string, double> fitness;
+// Fixation probability of a single mutant of strategy i among N - 1 agents of strategy j,
+// for every ordered pair, from many independent finite-population runs
+void SimulatorRunner::runFixation() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Finite Population Fixation (" << config_.finite << ")\n";
+    std::cout << "=================================================\n\n";
 
-    for (const auto& strat_i : strategies_) {
-        std::string name_i = strat_i->getName();
-        double pop_i = populations.at(name_i);
+    const SimulationContext& context = simulator_.getContext();
+    auto payoffs = estimatePayoffMatrix(context, 0);
+    for (auto& row : payoffs) {
+        for (double& payoff : row) payoff /= config_.rounds;
+    }
+    FinitePopulation population(payoffs, parseFiniteProcess(config_.finite), config_.population, config_.selection);
 
-        if (pop_i < 1e-6) {
-            fitness[name_i] = 0.0;
-            continue;
+    const int k = static_cast<int>(strategies_.size());
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k; ++j) {
+            if (i != j) pairs.push_back({ i, j });
         }
+    }
 
-        double total_fitness = 0.0;
+    // Every run has its own engine seeded from the pair and run index, so the
+    // estimates do not depend on the number of threads
+    const std::size_t runs = static_cast<std::size_t>(config_.trajectories);
+    std::vector<FinitePopulation::Outcome> outcomes(pairs.size() * runs);
+    simulator_.getThreadPool().parallelFor(outcomes.size(), [&](std::size_t task) {
+        const auto [mutant, resident] = pairs[task / runs];
+        std::vector<int> counts(k, 0);
+        counts[mutant] = 1;
+        counts[resident] = config_.population - 1;
+        RandomEngine engine(mixSeed(mixSeed(config_.seed, mutant * k + resident), task % runs), context.rng);
+        outcomes[task] = population.run(counts, config_.fixation_generations, engine);
+    });
+
+    std::vector<FixationEstimate> estimates;
+    for (std::size_t p = 0; p < pairs.size(); ++p) {
+        const auto [mutant, resident] = pairs[p];
+        FixationEstimate estimate;
+        estimate.mutant = strategies_[mutant]->getName();
+        estimate.resident = strategies_[resident]->getName();
+        estimate.runs = config_.trajectories;
+        double fixation_generations = 0.0;
+        for (std::size_t r = 0; r < runs; ++r) {
+            const auto& outcome = outcomes[p * runs + r];
+            if (outcome.fixed_type == mutant) {
+                ++estimate.fixations;
+                fixation_generations += outcome.generations;
+            }
+            else if (outcome.fixed_type < 0) {
+                ++estimate.unresolved;
+            }
+        }
+        estimate.probability = static_cast<double>(estimate.fixations) / estimate.runs;
+        std::tie(estimate.ci_low, estimate.ci_high) = FinitePopulation::wilsonInterval(estimate.fixations, estimate.runs);
+        estimate.mean_generations = estimate.fixations > 0 ? fixation_generations / estimate.fixations : 0.0;
+        estimates.push_back(estimate);
+    }
 
-        for (const auto& strat_j : strategies_) {
-            std::string name_j = strat_j->getName();
-            double pop_j = populations.at(name_j);
+    printer_.printFixationResults(estimates);
+}
 
-            if (pop_j < 1e-6) continue;
+// Spatial lattice: every cell plays its neighbors with the pairwise scores of one
+// tournament, then copies its best-scoring neighbor, for config_.generations generations
+void SimulatorRunner::runLattice() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Spatial Lattice (" << config_.lattice << " x " << config_.lattice
+              << " torus, " << config_.neighborhood << ")\n";
+    std::cout << "=================================================\n";
 
-            double avg_score = playMultipleGames(strat_i, strat_j, rounds, repeats);
-            total_fitness += avg_score * pop_j;
+    const SimulationContext& context = simulator_.getContext();
+    SpatialLattice lattice(config_.lattice, config_.lattice, estimatePayoffMatrix(context, 0),
+                           parseNeighborhood(config_.neighborhood));
+    RandomEngine engine(mixSeed(config_.seed, 0x4C41545449434Eull), context.rng); // "LATTICN"
+    lattice.randomize(engine);
+
+    const double cells = static_cast<double>(config_.lattice) * config_.lattice;
+    std::vector<std::map<std::string, double>> history;
+    auto start = std::chrono::steady_clock::now();
+    for (int gen = 0; gen < config_.generations; gen++) {
+        std::vector<long long> counts = lattice.counts();
+        std::map<std::string, double> shares;
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            shares[strategies_[i]->getName()] = counts[i] / cells;
+        }
+        printer_.printSCBEvolutionProgress(gen, shares, strategies_, context.enable_scb);
+        history.push_back(std::move(shares));
+
+        if (config_.snapshot_every > 0 && gen % config_.snapshot_every == 0) {
+            std::ostringstream filename;
+            filename << "lattice_gen" << std::setw(6) << std::setfill('0') << gen << ".bin";
+            OutputExporter::exportLatticeSnapshot(lattice.types(), lattice.width(), lattice.height(), gen,
+                                                  strategies_, filename.str());
         }
 
-        fitness[name_i] = total_fitness;
+        if (gen == config_.generations - 1) break;
+        lattice.step(&simulator_.getThreadPool());
     }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    return fitness;
+    std::string label = "Lattice " + std::to_string(config_.lattice) + "x" + std::to_string(config_.lattice)
+                      + ", " + config_.neighborhood;
+    printer_.printEvolutionHistory(history, strategies_, label);
+    if (history.size() > 1) {
+        std::cout << "Lattice updates: " << std::fixed << std::setprecision(1)
+                  << cells * (history.size() - 1) / seconds / 1e6 << " M cells/s\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    if (config_.snapshot_every > 0) {
+        std::cout << "Lattice snapshots written to lattice_gen*.bin every " << config_.snapshot_every << " generations\n";
+    }
+
+    // Share time series in the evolution export format
+    if (config_.format == "csv") {
+        std::string filename = generateOutputFilename("lattice_shares", ".csv");
+        if (!filename.empty()) OutputExporter::exportEvolutionCSV(history, strategies_, label, filename);
+    } else if (config_.format == "json") {
+        std::string filename = generateOutputFilename("lattice_shares", ".json");
+        if (!filename.empty()) OutputExporter::exportEvolutionJSON(history, strategies_, label, filename);
+    }
 }
 
-double SimulatorRunner::playMultipleGames(
-    const std::unique_ptr<Strategy>& strat_i,
-    const std::unique_ptr<Strategy>& strat_j,
-    int rounds, int repeats) {
+// Graph evolution: strategies on the nodes of a generated or loaded network imitate
+// their neighbors for config_.generations generations
+void SimulatorRunner::runGraphEvolution() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Graph Evolution (" << config_.graph << ", " << config_.graph_update << " updates)\n";
+    std::cout << "=================================================\n\n";
 
-    double total_score = 0.0;
-    bool is_self_play = (strat_i->getName() == strat_j->getName());
+    const SimulationContext& context = simulator_.getContext();
+    RandomEngine engine(mixSeed(config_.seed, 0x4752415048ull), context.rng); // "GRAPH"
+    const std::uint32_t nodes = static_cast<std::uint32_t>(config_.graph_nodes);
+    InteractionGraph graph;
+    if (config_.graph == "small-world") {
+        graph = InteractionGraph::smallWorld(nodes, config_.graph_degree, config_.rewire, engine);
+    } else if (config_.graph == "scale-free") {
+        graph = InteractionGraph::scaleFree(nodes, config_.graph_degree, engine);
+    } else {
+        graph = InteractionGraph::fromFile(config_.graph);
+    }
+    std::cout << "Nodes: " << graph.nodes() << ", edges: " << graph.edges()
+              << ", mean degree: " << std::fixed << std::setprecision(2) << 2.0 * graph.edges() / graph.nodes()
+              << ", max degree: " << graph.maxDegree()
+              << ", adjacency: " << std::setprecision(1) << graph.bytes() / 1048576.0 << " MB\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    // Payoffs per round, so the Fermi selection intensity means the same as in --finite
+    auto payoffs = estimatePayoffMatrix(context, 0);
+    for (auto& row : payoffs) {
+        for (double& payoff : row) payoff /= config_.rounds;
+    }
+    GraphEvolution evolution(graph, payoffs);
+    evolution.randomize(engine);
 
-    for (int r = 0; r < repeats; ++r) {
-        strat_i->reset();
-        strat_j->reset();
+    const GraphUpdate update = parseGraphUpdate(config_.graph_update);
+    ThreadPool* pool = &simulator_.getThreadPool();
+    std::vector<std::map<std::string, double>> history;
+    for (int gen = 0; gen < config_.generations; gen++) {
+        std::vector<long long> counts = evolution.counts();
+        std::map<std::string, double> shares;
+        for (size_t i = 0; i < strategies_.size(); ++i) {
+            shares[strategies_[i]->getName()] = static_cast<double>(counts[i]) / graph.nodes();
+        }
+        printer_.printSCBEvolutionProgress(gen, shares, strategies_, context.enable_scb);
+        history.push_back(std::move(shares));
 
-        auto scores = [&]() {
-            if (is_self_play) {
-                auto clone = strat_i->clone();
-                return simulator_.runGame(strat_i, clone, rounds);
-            }
-            else {
-                return simulator_.runGame(strat_i, strat_j, rounds);
-            }
-        }();
-        total_score += scores.first;
+        if (gen == config_.generations - 1) break;
+        if (update == GraphUpdate::SYNC) {
+            evolution.syncStep(pool);
+        } else {
+            evolution.asyncStep(pool, config_.selection, engine);
+        }
     }
 
-    return total_score / repeats;
+    std::string label = "Graph " + config_.graph + ", " + config_.graph_update;
+    printer_.printEvolutionHistory(history, strategies_, label);
+
+    // Share time series in the evolution export format
+    if (config_.format == "csv") {
+        std::string filename = generateOutputFilename("graph_shares", ".csv");
+        if (!filename.empty()) OutputExporter::exportEvolutionCSV(history, strategies_, label, filename);
+    } else if (config_.format == "json") {
+        std::string filename = generateOutputFilename("graph_shares", ".json");
+        if (!filename.empty()) OutputExporter::exportEvolutionJSON(history, strategies_, label, filename);
+    }
 }
 
-void SimulatorRunner::updatePopulations(
-    std::map<std::string, double>& populations,
-    const std::map<std::string, double>& fitness) {
+// Island model: config_.islands sub-populations evolve independently between migrations;
+// every migration_every generations a share of each island moves to the next one in a ring
+void SimulatorRunner::runIslands() {
+    const bool finite = !config_.finite.empty();
+    std::cout << "\n=================================================\n";
+    std::cout << "    Island Model (" << config_.islands << " islands, "
+              << (finite ? config_.finite : config_.replicator + " replicator") << " dynamics)\n";
+    std::cout << "=================================================\n\n";
 
-    double avg_fitness = 0.0;
-    for (const auto& [name, pop] : populations) {
-        avg_fitness += fitness.at(name) * pop;
+    const SimulationContext& context = simulator_.getContext();
+    const std::size_t k = strategies_.size();
+    const std::size_t islands = static_cast<std::size_t>(config_.islands);
+
+    // Replicator islands use match scores like --evolve, finite ones payoffs per round like --finite
+    auto payoffs = estimatePayoffMatrix(context, 0);
+    ReplicatorSolver::Options options = replicatorOptions();
+    options.tolerance = 0.0;  // migration moves the shares again, so run every generation
+    options.pool = nullptr;   // the islands themselves are spread over the pool
+    ReplicatorSolver solver(payoffs, options);
+    std::optional<FinitePopulation> population;
+    if (finite) {
+        for (auto& row : payoffs) {
+            for (double& payoff : row) payoff /= config_.rounds;
+        }
+        population.emplace(payoffs, parseFiniteProcess(config_.finite), config_.population, config_.selection);
     }
 
-    if (avg_fitness < 1e-9) {
+    // Every island starts from its own uniformly random mix and keeps its own engine,
+    // so the run does not depend on the number of threads
+    std::vector<RandomEngine> engines;
+    std::vector<std::vector<double>> shares(islands, std::vector<double>(k));
+    std::vector<std::vector<int>> counts(islands, std::vector<int>(k, 0));
+    for (std::size_t island = 0; island < islands; ++island) {
+        engines.emplace_back(mixSeed(mixSeed(config_.seed, 0x49534C414E44ull), island), context.rng); // "ISLAND"
+        double total = 0.0;
+        for (double& share : shares[island]) {
+            share = -std::log(1.0 - uniformClosedOpen(engines[island]));
+            total += share;
+        }
+        for (double& share : shares[island]) share /= total;
+
+        if (finite) {
+            int placed = 0;
+            for (std::size_t i = 0; i < k; ++i) {
+                counts[island][i] = static_cast<int>(shares[island][i] * config_.population);
+                placed += counts[island][i];
+            }
+            for (; placed < config_.population; ++placed) ++counts[island][uniformIndex(engines[island], k)];
+        }
+    }
+    auto current = [&](std::size_t island) {
+        if (!finite) return shares[island];
+        std::vector<double> fractions(k);
+        for (std::size_t i = 0; i < k; ++i) fractions[i] = static_cast<double>(counts[island][i]) / config_.population;
+        return fractions;
+    };
+
+    std::vector<std::vector<std::vector<double>>> trajectories(islands);
+    std::vector<char> stalled(islands, 0);
+    if (config_.generations > 0) {
+        for (std::size_t island = 0; island < islands; ++island) trajectories[island].push_back(current(island));
+    }
+
+    const int migrants = static_cast<int>(std::lround(config_.migration_rate * config_.population));
+    int migrations = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    for (int start = 0; start < config_.generations - 1; start += config_.migration_every) {
+        const int span = std::min(config_.migration_every, config_.generations - 1 - start);
+
+        // Islands only meet at the end of each epoch
+        simulator_.getThreadPool().parallelFor(islands, [&](std::size_t island) {
+            if (finite) {
+                for (int gen = 0; gen < span; ++gen) {
+                    population->advance(counts[island], 1, engines[island]);
+                    trajectories[island].push_back(current(island));
+                }
+            }
+            else {
+                auto segment = solver.run(shares[island], span + 1);
+                trajectories[island].insert(trajectories[island].end(), segment.trajectory.begin() + 1, segment.trajectory.end());
+                shares[island] = segment.trajectory.back();
+                stalled[island] = stalled[island] || segment.stalled;
+            }
+        });
+        if (start + span == config_.generations - 1) break;
+
+        // Migration to the next island in the ring; the history keeps the shares before it
+        if (finite) {
+            std::vector<std::vector<int>> leaving(islands, std::vector<int>(k, 0));
+            for (std::size_t island = 0; island < islands; ++island) {
+                int remaining = config_.population;
+                for (int m = 0; m < migrants; ++m, --remaining) {
+                    std::size_t pick = uniformIndex(engines[island], static_cast<std::size_t>(remaining));
+                    std::size_t type = 0;
+                    while (pick >= static_cast<std::size_t>(counts[island][type])) pick -= counts[island][type++];
+                    --counts[island][type];
+                    ++leaving[island][type];
+                }
+            }
+            for (std::size_t island = 0; island < islands; ++island) {
+                auto& arriving = leaving[(island + islands - 1) % islands];
+                for (std::size_t i = 0; i < k; ++i) counts[island][i] += arriving[i];
+            }
+        }
+        else {
+            std::vector<std::vector<double>> mixed(islands, std::vector<double>(k));
+            for (std::size_t island = 0; island < islands; ++island) {
+                const auto& neighbor = shares[(island + islands - 1) % islands];
+                for (std::size_t i = 0; i < k; ++i) {
+                    mixed[island][i] = (1.0 - config_.migration_rate) * shares[island][i] + config_.migration_rate * neighbor[i];
+                }
+            }
+            shares.swap(mixed);
+        }
+        ++migrations;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (std::find(stalled.begin(), stalled.end(), 1) != stalled.end()) {
         std::cerr << "Warning: Average fitness is too low, skipping update.\n";
-        return;
     }
 
-    std::map<std::string, double> new_populations;
-    for (const auto& [name, pop] : populations) {
-        new_populations[name] = pop * (fitness.at(name) / avg_fitness);  //new_population = old_population × (fitness / average_fitness)
+    // Per-island histories, and the mean over the islands as the overall history
+    auto named = [&](const std::vector<double>& generation) {
+        std::map<std::string, double> populations;
+        for (std::size_t i = 0; i < k; ++i) populations[strategies_[i]->getName()] = generation[i];
+        return populations;
+    };
+    std::vector<std::vector<std::map<std::string, double>>> histories(islands);
+    std::vector<std::map<std::string, double>> history;
+    for (int gen = 0; gen < config_.generations; gen++) {
+        std::vector<double> mean(k, 0.0);
+        for (std::size_t island = 0; island < islands; ++island) {
+            histories[island].push_back(named(trajectories[island][gen]));
+            for (std::size_t i = 0; i < k; ++i) mean[i] += trajectories[island][gen][i] / islands;
+        }
+        history.push_back(named(mean));
+        printer_.printSCBEvolutionProgress(gen, history.back(), strategies_, context.enable_scb);
     }
+    printer_.printEvolutionHistory(history, strategies_, "Islands, mean");
 
-    populations = new_populations;
+    std::vector<std::vector<double>> final_shares;
+    for (const auto& trajectory : trajectories) {
+        if (!trajectory.empty()) final_shares.push_back(trajectory.back());
+    }
+    if (!final_shares.empty()) printer_.printIslandSummary(final_shares, strategies_);
+    std::cout << migrations << " migrations; " << std::fixed << std::setprecision(1)
+              << islands * std::max(0, config_.generations - 1) / seconds << " island generations/s\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    // One share time series per island in the evolution export format
+    if (config_.format == "csv" || config_.format == "json") {
+        const std::string extension = "." + config_.format;
+        for (std::size_t island = 0; island < islands; ++island) {
+            std::string label = "Island " + std::to_string(island);
+            std::string filename = generateOutputFilename("island" + std::to_string(island) + "_evolution", extension);
+            if (filename.empty()) continue;
+            if (config_.format == "csv") OutputExporter::exportEvolutionCSV(histories[island], strategies_, label, filename);
+            else OutputExporter::exportEvolutionJSON(histories[island], strategies_, label, filename);
+        }
+    }
+}
 
-    double sum = 0.0;
-    for (const auto& [name, pop] : populations) {
-        sum += pop;
+// Genetic search over deterministic memory-n lookup tables. A genome is the 4^n defect
+// bits of a table followed by its n opening moves; its fitness is its mean match score
+// against every strategy of the field.
+void SimulatorRunner::runOptimize() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Genetic Search (memory-" << config_.optimize_depth << " lookup tables)\n";
+    std::cout << "=================================================\n\n";
+
+    const SimulationContext& context = simulator_.getContext();
+    const int depth = config_.optimize_depth;
+    const std::size_t table = std::size_t(1) << (2 * depth);
+    auto strategyOf = [&](const GeneticOptimizer::Genome& genome) -> StrategyPtr {
+        std::vector<bool> defect(genome.begin(), genome.begin() + table);
+        std::vector<Move> opening;
+        for (int round = 0; round < depth; ++round) {
+            opening.push_back(genome[table + round] ? Move::Defect : Move::Cooperate);
+        }
+        return LookupTableStrategy::memoryN(depth, defect, opening);
+    };
+
+    const std::size_t elite = std::max(1, config_.ga_population / 4);
+    GeneticOptimizer optimizer(table + depth, config_.ga_population, elite, config_.mutation_rate);
+    RandomEngine engine(mixSeed(config_.seed, 0x4F5054494D495A45ull), context.rng); // "OPTIMIZE"
+    optimizer.randomize(engine);
+
+    // Pairing seeds come from the strategy names, so a genome scores the same in every
+    // generation and the optimizer may cache it; the genomes are spread over the pool
+    auto score = [&](const std::vector<GeneticOptimizer::Genome>& genomes, std::vector<double>& fitness) {
+        simulator_.getThreadPool().parallelFor(genomes.size(), [&](std::size_t g) {
+            StrategyPtr candidate = strategyOf(genomes[g]);
+            MatchHistory history;
+            double total = 0.0;
+            for (const auto& opponent : strategies_) {
+                for (const OutcomeCounts& counts : simulator_.playPairingCounts(candidate, opponent, config_.rounds,
+                                                                                config_.repeats, history, context)) {
+                    total += simulator_.scoreGame(*candidate, *opponent, counts, simulator_.getPayoffMatrix(), context).first;
+                }
+            }
+            fitness[g] = total / (static_cast<double>(strategies_.size()) * config_.repeats);
+        });
+    };
+
+    std::vector<OptimizationStep> steps;
+    std::size_t scored = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    for (int gen = 0; gen < config_.generations; ++gen) {
+        if (gen > 0) optimizer.breed(engine);
+
+        OptimizationStep step;
+        step.generation = gen;
+        step.scored = optimizer.evaluate(score);
+        const auto& fitness = optimizer.fitness();
+        const std::size_t best = optimizer.best();
+        step.best = strategyOf(optimizer.population()[best])->getName();
+        step.best_fitness = fitness[best];
+        for (double f : fitness) step.mean_fitness += f / fitness.size();
+        scored += step.scored;
+        steps.push_back(step);
     }
-    if (std::abs(sum - 1.0) > 1e-6) {
-        std::cerr << "Warning: Population sum = " << sum << " (should be 1.0)\n";
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    printer_.printOptimizationHistory(steps);
+    std::cout << scored << " genomes scored, " << optimizer.cacheHits() << " served from the cache; "
+              << std::fixed << std::setprecision(1) << config_.generations / seconds << " generations/s\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    // Best genome and fitness of every generation
+    if (config_.format == "csv" || config_.format == "json") {
+        std::string filename = generateOutputFilename("optimization", "." + config_.format);
+        if (!filename.empty()) {
+            if (config_.format == "csv") OutputExporter::exportOptimizationCSV(steps, filename);
+            else OutputExporter::exportOptimizationJSON(steps, filename);
+        }
     }
 }
 
@@ -416,19 +892,13 @@ std::map<double, std::map<std::string, DoubleScoreStats>>
 SimulatorRunner::executeNoiseSweep(const std::vector<double>& epsilon_values) {
     std::map<double, std::map<std::string, DoubleScoreStats>> all_results;
     
-    for (double epsilon : epsilon_values) {
-        std::cout << "\n--- Running tournament with epsilon = " << epsilon << " ---\n";
-        
-        // Set current noise level
-        Strategy::setNoise(epsilon);
-        
-        // Reset all strategy states
-        for (auto& strategy : strategies_) {
-            strategy->reset();
-        }
-        
-        // Run tournament
-        auto [stats, matchResults] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats);
+    // Run the tournaments of all noise levels concurrently; print only once all have finished
+    auto levels = simulator_.runTournamentSweep(strategies_, config_.rounds, config_.repeats, epsilon_values);
+    
+    for (size_t k = 0; k < epsilon_values.size(); ++k) {
+        double epsilon = epsilon_values[k];
+        const auto& [stats, matchResults] = levels[k];
+        std::cout << "\n--- Tournament with epsilon = " << epsilon << " ---\n";
         
         // Print match matrix
         printer_.printMatchTable(strategies_, matchResults);
@@ -439,9 +909,6 @@ SimulatorRunner::executeNoiseSweep(const std::vector<double>& epsilon_values) {
 		printer_.printTournamentResults(stats);
     }
     
-    // Restore original noise setting
-    Strategy::setNoise(config_.epsilon);
-    
     return all_results;
 }
 
@@ -475,15 +942,14 @@ void SimulatorRunner::runSCBComparison() {
 
     // First run: WITHOUT SCB
     std::cout << "\n--- Running Tournament WITHOUT SCB ---\n";
-    Strategy::enableSCB(false);
-    auto [results_without_scb, matchResults1] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats);
+    auto [results_without_scb, matchResults1] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats,
+                                                                         simulator_.getContext().withSCB(false));
     printer_.printMatchTable(strategies_, matchResults1);
 
     // Second run: WITH SCB
     std::cout << "\n--- Running Tournament WITH SCB ---\n";
-    Strategy::enableSCB(true);
-    Strategy::setSCBCostFactor(config_.scb_cost_factor);
-    auto [results_with_scb, matchResults2] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats);
+    auto [results_with_scb, matchResults2] = simulator_.runTournament(strategies_, config_.rounds, config_.repeats,
+                                                                      simulator_.getContext().withSCB(true));
     printer_.printMatchTable(strategies_, matchResults2);
 
     // Print comparison results
@@ -513,9 +979,6 @@ void SimulatorRunner::runSCBComparison() {
             }
         }
     }
-
-    // Restore original configuration
-    Strategy::enableSCB(config_.enable_scb);
 }
 
 // Q3: Show exploiter vs opponent detailed matches
@@ -540,26 +1003,20 @@ void SimulatorRunner::runShowExploiter() {
     std::cout << "\n";
     
     // Detailed match against each victim strategy
+    MatchHistory history;
     for (size_t i = 1; i < strategies_.size(); ++i) {
         const auto& victim = strategies_[i];
         std::string victim_name = victim->getName();
         
-        std::vector<double> exploiter_scores;
-        std::vector<double> victim_scores;
-
-        // Run multiple repeated experiments
-        for (int r = 0; r < config_.repeats; ++r) {
-            exploiter->reset();
-            victim->reset();
-
-            auto scores = simulator_.runGame(exploiter, victim, config_.rounds);
-            exploiter_scores.push_back(scores.first);
-            victim_scores.push_back(scores.second);
-        }
+        // Run multiple repeated experiments, or take them from the result cache
+        const SimulationContext& context = simulator_.getContext();
+        OutcomeTensor::Cell games = simulator_.playPairingCell(exploiter, victim, config_.rounds, config_.repeats, history, context);
+        auto [exploiter_scores, victim_scores] = simulator_.scorePairingCell(*exploiter, *victim, games,
+                                                                            simulator_.getPayoffMatrix(), config_.rounds, context);
 
         // Calculate statistics
-        auto exploiter_stats = simulator_.calculateStats(exploiter_scores);
-        auto victim_stats = simulator_.calculateStats(victim_scores);
+        auto exploiter_stats = simulator_.statsFromMoments(exploiter_scores);
+        auto victim_stats = simulator_.statsFromMoments(victim_scores);
         
         // Use ResultsPrinter to print detailed results
         printer_.showExploiterVsOpponent(
@@ -602,29 +1059,22 @@ void SimulatorRunner::runExploiterNoiseComparison() {
     // Test two noise levels: 0.0 and config_.epsilon
     std::vector<double> noise_levels = {0.0, config_.epsilon};
     std::map<double, std::map<std::string, std::pair<DoubleScoreStats, DoubleScoreStats>>> results;
+    MatchHistory history;
     
     for (double epsilon : noise_levels) {
-        Strategy::setNoise(epsilon);
+        SimulationContext context = simulator_.getContext().withNoise(epsilon);
         std::cout << "\n--- Testing with epsilon = " << epsilon << " ---\n";
         
         for (size_t i = 1; i < strategies_.size(); ++i) {
             const auto& victim = strategies_[i];
             std::string victim_name = victim->getName();
             
-            std::vector<double> exploiter_scores;
-            std::vector<double> victim_scores;
-            
-            for (int r = 0; r < config_.repeats; ++r) {
-                exploiter->reset();
-                victim->reset();
-                
-                auto scores = simulator_.runGame(exploiter, victim, config_.rounds);
-                exploiter_scores.push_back(scores.first);
-                victim_scores.push_back(scores.second);
-            }
+            OutcomeTensor::Cell games = simulator_.playPairingCell(exploiter, victim, config_.rounds, config_.repeats, history, context);
+            auto [exploiter_scores, victim_scores] = simulator_.scorePairingCell(*exploiter, *victim, games,
+                                                                                simulator_.getPayoffMatrix(), config_.rounds, context);
             
-            auto exploiter_stats = simulator_.calculateStats(exploiter_scores);
-            auto victim_stats = simulator_.calculateStats(victim_scores);
+            auto exploiter_stats = simulator_.statsFromMoments(exploiter_scores);
+            auto victim_stats = simulator_.statsFromMoments(victim_scores);
             
             results[epsilon][victim_name] = {exploiter_stats, victim_stats};
             
@@ -640,12 +1090,291 @@ void SimulatorRunner::runExploiterNoiseComparison() {
     // Print noise comparison analysis
     printer_.printExploiterNoiseComparison(exploiter_name, results, config_.repeats);
     
-    // Restore original noise setting
-    Strategy::setNoise(config_.epsilon);
-    
     std::cout << "\n--- Exploiter noise comparison completed ---\n";
 }
 
+// Benchmark: compare rounds/sec of the virtual, inlined and FSM match paths for every strategy pair
+void SimulatorRunner::runBenchmark() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Match Engine Benchmark\n";
+    std::cout << "=================================================\n\n";
+
+    // Repeat the batch until it has run long enough to time reliably
+    auto measure = [&](auto&& play_batch) {
+        using clock = std::chrono::steady_clock;
+        const double min_seconds = 0.2;
+        long long rounds_played = 0;
+        auto start = clock::now();
+        double elapsed = 0.0;
+        do {
+            rounds_played += play_batch();
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_seconds);
+        return rounds_played / elapsed;
+    };
+
+    std::vector<BenchmarkResult> results;
+    MatchHistory history;
+    const SimulationContext& context = simulator_.getContext();
+    StrategyState state1(mixSeed(config_.seed, 1), context.rng);
+    StrategyState state2(mixSeed(config_.seed, 2), context.rng);
+    volatile double sink = 0.0; // keeps the optimizer from dropping unused match results
+    for (size_t i = 0; i < strategies_.size(); ++i) {
+        for (size_t j = i + 1; j < strategies_.size(); ++j) {
+            const auto& p1 = strategies_[i];
+            const auto& p2 = strategies_[j];
+
+            BenchmarkResult result;
+            result.matchup = p1->getName() + " vs " + p2->getName();
+            result.virtual_rounds_per_sec = measure([&]() {
+                for (int r = 0; r < config_.repeats; ++r) {
+                    state1.reset();
+                    state2.reset();
+                    sink = sink + simulator_.countGameLoop(p1, p2, state1, state2, config_.rounds, history, context, false).rounds[0];
+                }
+                return static_cast<long long>(config_.rounds) * config_.repeats;
+            });
+            result.inlined_rounds_per_sec = measure([&]() {
+                for (int r = 0; r < config_.repeats; ++r) {
+                    state1.reset();
+                    state2.reset();
+                    sink = sink + simulator_.countGameLoop(p1, p2, state1, state2, config_.rounds, history, context, true).rounds[0];
+                }
+                return static_cast<long long>(config_.rounds) * config_.repeats;
+            });
+
+            StrategyFSM fsm1, fsm2;
+            if (p1->exportFSM(fsm1) && p2->exportFSM(fsm2)) {
+                FSMKernel<double> kernel(fsm1, fsm2, simulator_.getPayoffMatrix());
+                result.fsm_rounds_per_sec = measure([&]() {
+                    for (int r = 0; r < config_.repeats; ++r) {
+                        sink = sink + kernel.play(*p1, *p2, state1, state2, context.noise, config_.rounds).first;
+                    }
+                    return static_cast<long long>(config_.rounds) * config_.repeats;
+                });
+
+                // One full block of lanes per batch, at the configured noise level
+                BitSlicedKernel<double, 4> sliced(fsm1, fsm2, simulator_.getPayoffMatrix());
+                std::vector<std::pair<double, double>> lanes;
+                std::uint64_t block = 0;
+                result.bitsliced_rounds_per_sec = measure([&]() {
+                    lanes.clear();
+                    sliced.play(config_.rounds, context.noise, context.noise, mixSeed(config_.seed, block++),
+                                BitSlicedKernel<double, 4>::LANES, lanes, context.rng);
+                    sink = sink + lanes.front().first;
+                    return static_cast<long long>(config_.rounds) * BitSlicedKernel<double, 4>::LANES;
+                });
+            }
+            results.push_back(result);
+        }
+    }
+
+    printer_.printBenchmarkResults(results);
+
+    // RNG engines: memory per match state and raw / uniform draw throughput
+    std::vector<RngBenchmarkResult> engines;
+    for (RngKind kind : { RngKind::MT19937, RngKind::XOSHIRO256PP, RngKind::PCG32, RngKind::PHILOX }) {
+        StrategyState state(mixSeed(config_.seed, 0x524E47), kind); // "RNG"
+        RngBenchmarkResult engine;
+        engine.engine = rngKindName(kind);
+        engine.engine_bytes = state.rng.stateBytes();
+        engine.state_bytes = sizeof(StrategyState) + state.rng.heapBytes();
+
+        const long long batch = 1000000;
+        engine.draws_per_sec = measure([&]() {
+            std::uint64_t bits = 0;
+            for (long long d = 0; d < batch; ++d) bits ^= state.rng();
+            sink = sink + static_cast<double>(bits & 1u);
+            return batch;
+        });
+        engine.uniforms_per_sec = measure([&]() {
+            double sum = 0.0;
+            for (long long d = 0; d < batch; ++d) sum += state.uniform();
+            sink = sink + sum;
+            return batch;
+        });
+        engines.push_back(engine);
+    }
+    printer_.printRngBenchmark(engines);
+
+    // Noise sampling: the geometric flip countdown (StrategyState::flipNext) against the
+    // per-move Bernoulli draw it replaced. Both samplers play the same number of moves in
+    // blocks; the flip rates and the distributions of flips per block must agree.
+    const int block_moves = 100;
+    const int blocks = 10000;
+    std::vector<double> levels = { 0.001, 0.01, 0.05, 0.2, 0.5 };
+    if (config_.epsilon > 0.0 && std::find(levels.begin(), levels.end(), config_.epsilon) == levels.end()) {
+        levels.push_back(config_.epsilon);
+    }
+
+    std::vector<NoiseSamplingCheck> checks;
+    for (size_t k = 0; k < levels.size(); ++k) {
+        double epsilon = levels[k];
+        StrategyState bernoulli(mixSeed(config_.seed, 2 * k + 3), context.rng);
+        StrategyState geometric(mixSeed(config_.seed, 2 * k + 4), context.rng);
+
+        std::vector<long long> hist_bernoulli(block_moves + 1), hist_geometric(block_moves + 1);
+        long long flips_bernoulli = 0, flips_geometric = 0;
+        for (int b = 0; b < blocks; ++b) {
+            int nb = 0, ng = 0;
+            for (int m = 0; m < block_moves; ++m) {
+                nb += bernoulli.uniform() < epsilon ? 1 : 0;
+                ng += geometric.flipNext(epsilon) ? 1 : 0;
+            }
+            ++hist_bernoulli[nb];
+            ++hist_geometric[ng];
+            flips_bernoulli += nb;
+            flips_geometric += ng;
+        }
+
+        NoiseSamplingCheck check;
+        check.epsilon = epsilon;
+        check.moves = static_cast<long long>(blocks) * block_moves;
+        check.bernoulli_rate = static_cast<double>(flips_bernoulli) / check.moves;
+        check.geometric_rate = static_cast<double>(flips_geometric) / check.moves;
+
+        // Two-proportion z-test of the flip rates
+        double pooled = (check.bernoulli_rate + check.geometric_rate) / 2.0;
+        double se = std::sqrt(pooled * (1.0 - pooled) * 2.0 / check.moves);
+        double z = se > 0.0 ? (check.bernoulli_rate - check.geometric_rate) / se : 0.0;
+        check.rate_p_value = std::erfc(std::abs(z) / std::sqrt(2.0));
+
+        // Chi-square homogeneity test of flips per block; sparse counts are pooled
+        // until each bin expects at least 5 blocks per sampler
+        std::vector<std::pair<long long, long long>> bins;
+        std::pair<long long, long long> open{ 0, 0 };
+        for (int n = 0; n <= block_moves; ++n) {
+            open.first += hist_bernoulli[n];
+            open.second += hist_geometric[n];
+            if (open.first + open.second >= 10) {
+                bins.push_back(open);
+                open = { 0, 0 };
+            }
+        }
+        if (!bins.empty()) {
+            bins.back().first += open.first;
+            bins.back().second += open.second;
+        }
+        for (const auto& [ob, og] : bins) {
+            double expected = (ob + og) / 2.0; // equal sample sizes
+            check.block_chi_square += (ob - expected) * (ob - expected) / expected
+                                    + (og - expected) * (og - expected) / expected;
+        }
+        check.block_dof = static_cast<int>(bins.size()) - 1;
+        if (check.block_dof > 0) {
+            // Wilson-Hilferty normal approximation of the chi-square tail
+            double d = check.block_dof;
+            double wh = (std::cbrt(check.block_chi_square / d) - (1.0 - 2.0 / (9.0 * d))) / std::sqrt(2.0 / (9.0 * d));
+            check.block_p_value = 0.5 * std::erfc(wh / std::sqrt(2.0));
+        }
+        else {
+            check.block_p_value = 1.0;
+        }
+
+        const long long batch = 1000000;
+        check.bernoulli_moves_per_sec = measure([&]() {
+            long long flips = 0;
+            for (long long m = 0; m < batch; ++m) flips += bernoulli.uniform() < epsilon ? 1 : 0;
+            sink = sink + flips;
+            return batch;
+        });
+        check.geometric_moves_per_sec = measure([&]() {
+            long long flips = 0;
+            for (long long m = 0; m < batch; ++m) flips += geometric.flipNext(epsilon) ? 1 : 0;
+            sink = sink + flips;
+            return batch;
+        });
+        checks.push_back(check);
+    }
+
+    printer_.printNoiseSamplingCheck(checks, block_moves);
+
+    // Replicator solver: random payoff matrices of growing size, run to convergence
+    const int max_generations = 1000000;
+    std::vector<ReplicatorBenchmarkResult> replicator_runs;
+    for (int size : { 100, 1000, 2000 }) {
+        std::mt19937_64 engine(mixSeed(config_.seed, 0x5245504C) + size); // "REPL"
+        std::uniform_real_distribution<double> payoff(0.0, 5.0);
+        std::vector<std::vector<double>> payoffs(size, std::vector<double>(size));
+        for (auto& row : payoffs) {
+            for (double& value : row) value = payoff(engine);
+        }
+
+        for (ReplicatorMethod method : { ReplicatorMethod::DISCRETE, ReplicatorMethod::RK45 }) {
+            ReplicatorSolver::Options options = replicatorOptions();
+            options.method = method;
+            options.record_every = 0;
+            ReplicatorSolver solver(payoffs, options);
+
+            auto start = std::chrono::steady_clock::now();
+            auto result = solver.run(std::vector<double>(size, 1.0 / size), max_generations);
+            ReplicatorBenchmarkResult run;
+            run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            run.method = replicatorMethodName(method);
+            run.strategies = size;
+            run.generations = result.converged_at >= 0 ? result.converged_at : max_generations - 1;
+            run.period = result.period;
+            run.steps = result.steps;
+            for (double share : result.trajectory.back()) {
+                if (share > 0.0) ++run.survivors;
+            }
+            replicator_runs.push_back(run);
+        }
+    }
+    printer_.printReplicatorBenchmark(replicator_runs, max_generations);
+
+    // Large tournaments: copies of the selected strategies, one game per pairing
+    std::vector<TournamentScalingResult> tournaments;
+    for (int size : { 250, 500, 1000 }) {
+        std::vector<std::unique_ptr<Strategy>> field;
+        for (int i = 0; i < size; ++i) {
+            field.push_back(createStrategy(config_.strategy_names[i % config_.strategy_names.size()]));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        OutcomeTensor tensor = simulator_.runTournamentOutcomes(field, config_.rounds, 1, context);
+        TournamentScalingResult run;
+        run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        run.strategies = size;
+        run.pairings = static_cast<long long>(size) * (size + 1) / 2;
+        run.tensor_bytes = tensor.bytes();
+        // A full cell: games (padded to 8 bytes), 4 counts and the 4 x 4 moments
+        run.full_bytes = static_cast<std::size_t>(size) * size * (1 + 4 + 16) * sizeof(double);
+        tournaments.push_back(run);
+    }
+    printer_.printTournamentScaling(tournaments);
+}
+
+// Payoff grid: play the tournament once, keeping outcome counts, and re-score it for every T/R/P/S combination
+void SimulatorRunner::runPayoffGrid() {
+    std::cout << "\n=================================================\n";
+    std::cout << "    Payoff Grid Analysis\n";
+    std::cout << "=================================================\n\n";
+
+    OutcomeTensor tensor = simulator_.runTournamentOutcomes(strategies_, config_.rounds, config_.repeats);
+    auto grid = simulator_.rescorePayoffGrid(tensor, config_.grid_T, config_.grid_R, config_.grid_P, config_.grid_S);
+
+    size_t combinations = config_.grid_T.size() * config_.grid_R.size() * config_.grid_P.size() * config_.grid_S.size();
+    printer_.printPayoffGridResults(grid, combinations);
+
+    // Export to file if format is specified
+    if (!config_.format.empty() && config_.format != "console") {
+        if (config_.format == "csv") {
+            std::string filename = generateOutputFilename("payoff_grid", ".csv");
+            if (!filename.empty()) {
+                OutputExporter::exportPayoffGridCSV(grid, filename);
+            }
+        } else if (config_.format == "json") {
+            std::string filename = generateOutputFilename("payoff_grid", ".json");
+            if (!filename.empty()) {
+                OutputExporter::exportPayoffGridJSON(grid, filename);
+            }
+        }
+    }
+
+    std::cout << "\n--- Payoff grid completed ---\n";
+}
+
 // Q3: Analyze exploiter performance in mixed population
 void SimulatorRunner::runMixedPopulationAnalysis() {
     // Detect whether there are exploiter strategies in the strategy list
@@ -680,15 +1409,98 @@ Config SimulatorRunner::parseArguments(int argc, char** argv) {
     
     // Output format parameter
     app.add_option("--format,--output-format,--output_format", config.format, "Output format (csv, json, markdown, or console). Default: console");
+    app.add_option("--match-matrix,--match_matrix", config.match_matrix,
+        "Write the tournament's pairwise score matrix to this CSV file, one row at a time.");
+    app.add_option("--cache", config.cache,
+        "Keep per-pairing results in this memory-mapped file and reuse them in later runs with the same settings.");
+    app.add_option("--samples", config.samples,
+        "Keep every game score of the tournament, not just running statistics, and write them to this CSV file (games are played, not read from --cache).");
 
     app.add_option("--rounds", config.rounds, "Number of rounds per match.");
     app.add_option("--repeats", config.repeats, "Number of repetitions per match to compute the average score.");
+    app.add_option("--ci-target,--ci_target", config.ci_target,
+        "Keep adding repeats to each pairing until the 95% CI half-width of its mean scores is at most this (0 = fixed --repeats).")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--max-repeats,--max_repeats", config.max_repeats,
+        "Most repeats per pairing with --ci-target.")
+        ->check(CLI::PositiveNumber);
     app.add_option("--epsilon", config.epsilon, "Probability of random action (error rate).");
     app.add_option("--seed", config.seed, "Random seed for reproducibility.");
     app.add_option("--payoffs", config.payoffs, "Payoff values [T, R, P, S].")->expected(4);
-    app.add_option("--strategies,--strategy_names", config.strategy_names, "List of participating strategies.");
+    app.add_option("--strategies,--strategy_names", config.strategy_names,
+        "List of participating strategies. Lookup tables: M1:pCC,pCD,pDC,pDD[,p0] or LT<n>:<hex>[:<opening>].");
     app.add_flag("--evolve", config.evolve, "Enable evolutionary simulation mode.");
     app.add_option("--generations", config.generations, "Number of generations for the evolutionary simulation.");
+    app.add_option("--payoff-refresh,--payoff_refresh", config.payoff_refresh,
+        "Re-estimate the evolution payoff matrix every N generations (0 = estimate once).");
+    app.add_option("--replicator", config.replicator,
+        "Replicator dynamics: discrete (default) map or rk45 continuous-time integration.")
+        ->check(CLI::IsMember({ "discrete", "rk45" }));
+    app.add_option("--convergence-tol,--convergence_tol", config.convergence_tol,
+        "Stop the evolution once the shares reach a fixed point or cycle within this tolerance (0 = run all generations).");
+
+    // Finite population parameters
+    app.add_option("--finite", config.finite,
+        "Estimate fixation probabilities of single mutants under a moran or wright-fisher process.")
+        ->check(CLI::IsMember({ "moran", "wright-fisher" }));
+    app.add_option("--population", config.population, "Number of agents in the finite population.")
+        ->check(CLI::Range(2, 1 << 30));
+    app.add_option("--trajectories", config.trajectories, "Independent runs per mutant/resident pair.")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--selection", config.selection,
+        "Selection intensity w: fitness = exp(w * average payoff per round); 0 = neutral drift.");
+    app.add_option("--fixation-generations,--fixation_generations", config.fixation_generations,
+        "Give up on a finite-population run after this many generations.")
+        ->check(CLI::PositiveNumber);
+
+    // Spatial lattice parameters
+    app.add_option("--lattice", config.lattice,
+        "Run the spatial game on a torus of N x N cells, each imitating its best-scoring neighbor (0 = off, 3 to 4096).")
+        ->check(CLI::Range(0, 0) | CLI::Range(3, 4096));
+    app.add_option("--neighborhood", config.neighborhood, "Lattice neighborhood: moore (8 cells, default) or von-neumann (4).")
+        ->check(CLI::IsMember({ "moore", "von-neumann" }));
+    app.add_option("--snapshot-every,--snapshot_every", config.snapshot_every,
+        "Write a binary lattice snapshot every N generations (0 = never).")
+        ->check(CLI::NonNegativeNumber);
+
+    // Graph evolution parameters
+    app.add_option("--graph", config.graph,
+        "Evolve on an interaction network: small-world, scale-free or the path of an edge-list file.");
+    app.add_option("--graph-nodes,--graph_nodes", config.graph_nodes, "Number of nodes of generated graphs.")
+        ->check(CLI::Range(3, 2000000000));
+    app.add_option("--graph-degree,--graph_degree", config.graph_degree, "Mean degree of generated graphs (even).")
+        ->check(CLI::Range(2, 100000));
+    app.add_option("--rewire", config.rewire, "Rewiring probability of small-world graphs.")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--graph-update,--graph_update", config.graph_update,
+        "Graph update rule: sync (copy best neighbor) or async (Fermi imitation with --selection).")
+        ->check(CLI::IsMember({ "sync", "async" }));
+
+    // Island model parameters
+    app.add_option("--islands", config.islands,
+        "Evolve N islands in parallel with migration between them (0 = off). "
+        "Islands follow --replicator dynamics, or --finite with --population agents each.")
+        ->check(CLI::Range(0, 65536));
+    app.add_option("--migration-every,--migration_every", config.migration_every,
+        "Generations between migrations of the island model.")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--migration-rate,--migration_rate", config.migration_rate,
+        "Share of each island that moves to the next island in the ring at every migration.")
+        ->check(CLI::Range(0.0, 1.0));
+
+    // Genetic search parameters
+    app.add_flag("--optimize", config.optimize,
+        "Evolve memory-n lookup-table strategies with a genetic algorithm for --generations generations; "
+        "fitness is the mean match score against the --strategies field.");
+    app.add_option("--optimize-depth,--optimize_depth", config.optimize_depth,
+        "Memory depth of the evolved lookup tables.")
+        ->check(CLI::Range(1, LookupTableStrategy::MAX_DEPTH));
+    app.add_option("--ga-population,--ga_population", config.ga_population,
+        "Genomes per generation of the genetic search.")
+        ->check(CLI::Range(2, 100000));
+    app.add_option("--mutation-rate,--mutation_rate", config.mutation_rate,
+        "Probability of flipping each bit of a child genome.")
+        ->check(CLI::Range(0.0, 1.0));
 
     // Noise sweep parameters - Support both hyphen and underscore formats
     app.add_flag("--noise-sweep,--noise_sweep", config.noise_sweep, "Enable noise sweep analysis mode.");
@@ -709,6 +1521,25 @@ Config SimulatorRunner::parseArguments(int argc, char** argv) {
     // SCB Comparison mode
     app.add_flag("--scb-compare,--scb_compare", config.scb_compare, "Enable SCB comparison mode (runs tournament with and without SCB).");
 
+    // Performance benchmark mode
+    app.add_flag("--benchmark", config.benchmark, "Benchmark rounds/sec of the virtual, inlined and FSM match paths for each strategy pair.");
+    app.add_flag("--self-test,--self_test", config.self_test, "Run the built-in regression checks and exit with status 0 if all checks pass, 1 otherwise.");
+    app.add_option("--threads", config.threads,
+        "Worker threads for tournaments (0 = all cores). Results are identical for any thread count.");
+    app.add_flag("--exact", config.exact,
+        "Compute exact expected scores for memory-one pairs (ALLC, ALLD, TFT, PAVLOV, RND) instead of sampling.");
+    app.add_option("--rng", config.rng,
+        "RNG engine for noise and random moves: mt19937 (default), xoshiro256pp, pcg32 or philox.")
+        ->check(CLI::IsMember({ "mt19937", "xoshiro256pp", "pcg32", "philox" }));
+
+    // Payoff grid mode
+    app.add_flag("--payoff-grid,--payoff_grid", config.payoff_grid,
+        "Run the tournament once and re-score it under every combination of the grid payoffs.");
+    app.add_option("--grid-T,--grid_T", config.grid_T, "Temptation (T) values for the payoff grid.");
+    app.add_option("--grid-R,--grid_R", config.grid_R, "Reward (R) values for the payoff grid.");
+    app.add_option("--grid-P,--grid_P", config.grid_P, "Punishment (P) values for the payoff grid.");
+    app.add_option("--grid-S,--grid_S", config.grid_S, "Sucker (S) values for the payoff grid.");
+
     try {
         app.parse(argc, argv);
     }
@@ -730,16 +1561,45 @@ Config SimulatorRunner::parseArguments(int argc, char** argv) {
             // Keep command-line overrides, use loaded config for unspecified values
             if (config.rounds == 50 && loadedConfig.rounds != 50) config.rounds = loadedConfig.rounds;
             if (config.repeats == 5 && loadedConfig.repeats != 5) config.repeats = loadedConfig.repeats;
+            if (config.ci_target == 0.0 && loadedConfig.ci_target != 0.0) config.ci_target = loadedConfig.ci_target;
+            if (config.max_repeats == 10000 && loadedConfig.max_repeats != 10000) config.max_repeats = loadedConfig.max_repeats;
             if (config.epsilon == 0 && loadedConfig.epsilon != 0) config.epsilon = loadedConfig.epsilon;
             if (config.seed == 42 && loadedConfig.seed != 42) config.seed = loadedConfig.seed;
             if (config.generations == 50 && loadedConfig.generations != 50) config.generations = loadedConfig.generations;
+            if (config.payoff_refresh == 0 && loadedConfig.payoff_refresh != 0) config.payoff_refresh = loadedConfig.payoff_refresh;
+            if (config.convergence_tol == 1e-10 && loadedConfig.convergence_tol != 1e-10) config.convergence_tol = loadedConfig.convergence_tol;
             if (config.scb_cost_factor == 0.1 && loadedConfig.scb_cost_factor != 0.1) config.scb_cost_factor = loadedConfig.scb_cost_factor;
+            if (config.population == 1000 && loadedConfig.population != 1000) config.population = loadedConfig.population;
+            if (config.trajectories == 200 && loadedConfig.trajectories != 200) config.trajectories = loadedConfig.trajectories;
+            if (config.selection == 0.1 && loadedConfig.selection != 0.1) config.selection = loadedConfig.selection;
+            if (config.fixation_generations == 100000 && loadedConfig.fixation_generations != 100000) config.fixation_generations = loadedConfig.fixation_generations;
+            if (config.lattice == 0 && loadedConfig.lattice != 0) config.lattice = loadedConfig.lattice;
+            if (config.snapshot_every == 0 && loadedConfig.snapshot_every != 0) config.snapshot_every = loadedConfig.snapshot_every;
+            if (config.graph_nodes == 10000 && loadedConfig.graph_nodes != 10000) config.graph_nodes = loadedConfig.graph_nodes;
+            if (config.graph_degree == 4 && loadedConfig.graph_degree != 4) config.graph_degree = loadedConfig.graph_degree;
+            if (config.rewire == 0.1 && loadedConfig.rewire != 0.1) config.rewire = loadedConfig.rewire;
+            if (config.islands == 0 && loadedConfig.islands != 0) config.islands = loadedConfig.islands;
+            if (config.migration_every == 10 && loadedConfig.migration_every != 10) config.migration_every = loadedConfig.migration_every;
+            if (config.migration_rate == 0.1 && loadedConfig.migration_rate != 0.1) config.migration_rate = loadedConfig.migration_rate;
+            if (config.optimize_depth == 3 && loadedConfig.optimize_depth != 3) config.optimize_depth = loadedConfig.optimize_depth;
+            if (config.ga_population == 40 && loadedConfig.ga_population != 40) config.ga_population = loadedConfig.ga_population;
+            if (config.mutation_rate == 0.01 && loadedConfig.mutation_rate != 0.01) config.mutation_rate = loadedConfig.mutation_rate;
             
             // For vectors and strings, use loaded if current is default
             if (config.payoffs.size() == 4 && config.payoffs[0] == 5.0) config.payoffs = loadedConfig.payoffs;
             if (config.strategy_names == loadedConfig.strategy_names || config.strategy_names.empty()) config.strategy_names = loadedConfig.strategy_names;
             if (config.epsilon_values.size() == 5) config.epsilon_values = loadedConfig.epsilon_values;
+            if (config.grid_T == Config().grid_T) config.grid_T = loadedConfig.grid_T;
+            if (config.grid_R == Config().grid_R) config.grid_R = loadedConfig.grid_R;
+            if (config.grid_P == Config().grid_P) config.grid_P = loadedConfig.grid_P;
+            if (config.grid_S == Config().grid_S) config.grid_S = loadedConfig.grid_S;
             if (config.format == "csv") config.format = loadedConfig.format;
+            if (config.rng == Config().rng) config.rng = loadedConfig.rng;
+            if (config.replicator == Config().replicator) config.replicator = loadedConfig.replicator;
+            if (config.finite.empty()) config.finite = loadedConfig.finite;
+            if (config.neighborhood == Config().neighborhood) config.neighborhood = loadedConfig.neighborhood;
+            if (config.graph.empty()) config.graph = loadedConfig.graph;
+            if (config.graph_update == Config().graph_update) config.graph_update = loadedConfig.graph_update;
             
             // Boolean flags
             if (!config.evolve) config.evolve = loadedConfig.evolve;
@@ -749,6 +1609,9 @@ Config SimulatorRunner::parseArguments(int argc, char** argv) {
             if (!config.exploiter_noise_compare) config.exploiter_noise_compare = loadedConfig.exploiter_noise_compare;
             if (!config.enable_scb) config.enable_scb = loadedConfig.enable_scb;
             if (!config.scb_compare) config.scb_compare = loadedConfig.scb_compare;
+            if (!config.exact) config.exact = loadedConfig.exact;
+            if (!config.payoff_grid) config.payoff_grid = loadedConfig.payoff_grid;
+            if (!config.optimize) config.optimize = loadedConfig.optimize;
         } else {
             config = loadedConfig;
             if (!config.load_file.empty()) {
@@ -759,6 +1622,14 @@ Config SimulatorRunner::parseArguments(int argc, char** argv) {
         }
     }
 
+    // The merged configuration gets the same checks as a loaded file
+    try {
+        ConfigIO::validateConfig(config);
+    }
+    catch (const std::exception& e) {
+        throw std::runtime_error("Invalid configuration: " + std::string(e.what()));
+    }
+
     // Save configuration to file if specified
     if (!config.save_file.empty()) {
         ConfigIO::saveConfig(config, config.save_file);
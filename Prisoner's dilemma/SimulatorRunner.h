@@ -10,6 +10,11 @@
 #include "Strategy.h"
 #include "Simulator.h"
 #include "ResultsPrinter.h"
+#include "ReplicatorSolver.h"
+#include "FinitePopulation.h"
+#include "SpatialLattice.h"
+#include "InteractionGraph.h"
+#include "GeneticOptimizer.h"
 
 /**
  * @class SimulatorRunner
@@ -31,9 +36,15 @@ public:
 
 private:
 
+    // The mode selected by the configuration
+    void runExperiment();
+
     // Factory function to create strategy instances from strategy names.
     static std::unique_ptr<Strategy> createStrategy(const std::string& name);
     Config config_;
+
+    // Larger tournaments do not print their match matrix to the console
+    static constexpr size_t MATCH_TABLE_LIMIT = 64;
     std::vector<std::unique_ptr<Strategy>> strategies_;
     DefaultSimulator simulator_;  // Using default double-based Simulator
     std::map<std::string, DoubleScoreStats> results_; // Store simulation results (including confidence intervals)
@@ -50,7 +61,23 @@ private:
     // New: Run evolution simulation
     void runEvolution();
     std::vector<std::map<std::string, double>> runSingleEvolution(double noise, const std::string& label);
-    std::map<std::string, double> calculateFitness(const std::map<std::string, double>& populations, int rounds, int repeats);
+    std::vector<std::vector<double>> estimatePayoffMatrix(const SimulationContext& context, int refresh);
+    ReplicatorSolver::Options replicatorOptions() const;
+
+    // Finite population: fixation probabilities of single mutants
+    void runFixation();
+
+    // Spatial lattice: best-neighbor imitation on a torus
+    void runLattice();
+
+    // Graph evolution: imitation on a small-world, scale-free or loaded network
+    void runGraphEvolution();
+
+    // Island model: parallel sub-populations with periodic migration
+    void runIslands();
+
+    // Genetic search: evolve memory-n lookup tables against the strategy field
+    void runOptimize();
     
     // New: Run noise sweep
     void runNoiseSweep();
@@ -65,17 +92,14 @@ private:
     // Q3: Run mixed population analysis
     void runMixedPopulationAnalysis();
 
-    double playMultipleGames(
-        const std::unique_ptr<Strategy>& strat_i,
-        const std::unique_ptr<Strategy>& strat_j,
-        int rounds, int repeats);
-
-    void updatePopulations(
-        std::map<std::string, double>& populations,
-		const std::map<std::string, double>& fitness);
-
     // SCB: Run tournament with SCB comparison
     void runSCBComparison();
+
+    // Benchmark: measure rounds/sec of the available match paths
+    void runBenchmark();
+
+    // Payoff grid: one tournament re-scored under many payoff matrices
+    void runPayoffGrid();
     void printExploiterMatchTable(
         const std::string& exploiter_name,
         const std::map<std::string, std::pair<double, double>>& matchAverages) const;
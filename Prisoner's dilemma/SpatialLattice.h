@@ -0,0 +1,190 @@
+﻿#ifndef SPATIALLATTICE_H
+#define SPATIALLATTICE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Random.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Neighbors each lattice cell plays and imitates
+ *   MOORE       - the 8 surrounding cells
+ *   VON_NEUMANN - the 4 orthogonally adjacent cells
+ */
+enum class Neighborhood {
+    MOORE,
+    VON_NEUMANN
+};
+
+inline std::string neighborhoodName(Neighborhood neighborhood) {
+    return neighborhood == Neighborhood::VON_NEUMANN ? "von-neumann" : "moore";
+}
+
+inline Neighborhood parseNeighborhood(const std::string& name) {
+    if (name == "moore") return Neighborhood::MOORE;
+    if (name == "von-neumann") return Neighborhood::VON_NEUMANN;
+    throw std::invalid_argument("Unknown neighborhood: " + name);
+}
+
+/**
+ * @brief Spatial IPD on a 2D torus: every cell holds one strategy, plays its neighbors
+ * and then copies the strategy of its best-scoring neighbor
+ *
+ * payoffs[i][j] is the average match score of strategy i against strategy j, so a cell's
+ * score is the sum of its row entries for its neighbors' strategies. Generations are
+ * synchronous: all scores are computed from the current grid, then every cell's next
+ * strategy is written to a second buffer and the buffers are swapped. A cell keeps its
+ * strategy unless a neighbor scored strictly more; ties go to the first such neighbor
+ * in row-major order.
+ *
+ * The grid is stored as separate arrays of strategy ids (2 bytes per cell) and scores.
+ * Both passes run over TILE x TILE tiles, which keeps a tile and its halo rows in
+ * cache, and the tiles are spread over a thread pool. Results do not depend on it.
+ */
+class SpatialLattice {
+public:
+    static constexpr int TILE = 64; // 64 x 64 cells: 8 KB of strategy ids, 32 KB of scores
+
+private:
+    int width_;
+    int height_;
+    std::size_t k_;
+    std::vector<double> payoffs_; // k x k, row-major
+    Neighborhood neighborhood_;
+    std::vector<std::uint16_t> type_;
+    std::vector<std::uint16_t> next_type_;
+    std::vector<double> score_;
+
+    int tilesX() const { return (width_ + TILE - 1) / TILE; }
+    int tilesY() const { return (height_ + TILE - 1) / TILE; }
+    std::size_t tiles() const { return static_cast<std::size_t>(tilesX()) * tilesY(); }
+
+    // Run work(x0, y0, x1, y1) for every tile, over the pool if there is one
+    template<typename Work>
+    void forEachTile(ThreadPool* pool, Work&& work) {
+        auto run = [&](std::size_t tile) {
+            int x0 = static_cast<int>(tile % tilesX()) * TILE;
+            int y0 = static_cast<int>(tile / tilesX()) * TILE;
+            work(x0, y0, std::min(x0 + TILE, width_), std::min(y0 + TILE, height_));
+        };
+        if (pool) {
+            pool->parallelFor(tiles(), run);
+        }
+        else {
+            for (std::size_t tile = 0; tile < tiles(); ++tile) run(tile);
+        }
+    }
+
+    // Visit the neighbors of (x, y) in row-major order as visit(row, column), where row
+    // is the start of the neighbor's row and column its wrapped x
+    template<bool Moore, typename Visit>
+    void forNeighbors(std::size_t up, std::size_t middle, std::size_t down,
+                      int left, int x, int right, Visit&& visit) const {
+        if (Moore) visit(up, left);
+        visit(up, x);
+        if (Moore) visit(up, right);
+        visit(middle, left);
+        visit(middle, right);
+        if (Moore) visit(down, left);
+        visit(down, x);
+        if (Moore) visit(down, right);
+    }
+
+    // Run cell(up, middle, down, left, x, right) for every cell of a tile; only the row
+    // and column indices wrap around the torus, once per row and once per cell
+    template<typename Cell>
+    void forCells(int x0, int y0, int x1, int y1, Cell&& cell) const {
+        for (int y = y0; y < y1; ++y) {
+            std::size_t up = index(0, y == 0 ? height_ - 1 : y - 1);
+            std::size_t middle = index(0, y);
+            std::size_t down = index(0, y == height_ - 1 ? 0 : y + 1);
+            for (int x = x0; x < x1; ++x) {
+                int left = x == 0 ? width_ - 1 : x - 1;
+                int right = x == width_ - 1 ? 0 : x + 1;
+                cell(up, middle, down, left, x, right);
+            }
+        }
+    }
+
+    template<bool Moore>
+    void scoreTile(int x0, int y0, int x1, int y1) {
+        forCells(x0, y0, x1, y1, [&](std::size_t up, std::size_t middle, std::size_t down, int left, int x, int right) {
+            const double* row = &payoffs_[type_[middle + x] * k_];
+            double score = 0.0;
+            forNeighbors<Moore>(up, middle, down, left, x, right, [&](std::size_t r, int c) {
+                score += row[type_[r + c]];
+            });
+            score_[middle + x] = score;
+        });
+    }
+
+    template<bool Moore>
+    void imitateTile(int x0, int y0, int x1, int y1) {
+        forCells(x0, y0, x1, y1, [&](std::size_t up, std::size_t middle, std::size_t down, int left, int x, int right) {
+            double best = score_[middle + x];
+            std::uint16_t type = type_[middle + x];
+            forNeighbors<Moore>(up, middle, down, left, x, right, [&](std::size_t r, int c) {
+                if (score_[r + c] > best) {
+                    best = score_[r + c];
+                    type = type_[r + c];
+                }
+            });
+            next_type_[middle + x] = type;
+        });
+    }
+
+    template<bool Moore>
+    void step(ThreadPool* pool) {
+        forEachTile(pool, [this](int x0, int y0, int x1, int y1) { scoreTile<Moore>(x0, y0, x1, y1); });
+        forEachTile(pool, [this](int x0, int y0, int x1, int y1) { imitateTile<Moore>(x0, y0, x1, y1); });
+        type_.swap(next_type_);
+    }
+
+public:
+    SpatialLattice(int width, int height, const std::vector<std::vector<double>>& payoffs, Neighborhood neighborhood)
+        : width_(width), height_(height), k_(payoffs.size()), payoffs_(k_ * k_), neighborhood_(neighborhood) {
+        if (width_ < 3 || height_ < 3) throw std::invalid_argument("Lattice must be at least 3 x 3");
+        if (k_ == 0 || k_ > 65536) throw std::invalid_argument("Lattice needs between 1 and 65536 strategies");
+        for (std::size_t i = 0; i < k_; ++i) {
+            if (payoffs[i].size() != k_) throw std::invalid_argument("Payoff matrix must be square");
+            std::copy(payoffs[i].begin(), payoffs[i].end(), payoffs_.begin() + i * k_);
+        }
+        const std::size_t cells = static_cast<std::size_t>(width_) * height_;
+        type_.assign(cells, 0);
+        next_type_.assign(cells, 0);
+        score_.assign(cells, 0.0);
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    std::size_t index(int x, int y) const { return static_cast<std::size_t>(y) * width_ + x; }
+
+    // Strategy id of every cell, row-major
+    const std::vector<std::uint16_t>& types() const { return type_; }
+
+    // Give every cell a uniformly random strategy
+    template<typename Engine>
+    void randomize(Engine& engine) {
+        for (auto& type : type_) type = static_cast<std::uint16_t>(uniformIndex(engine, k_));
+    }
+
+    // One synchronous generation: score every cell, then imitate the best neighbor
+    void step(ThreadPool* pool = nullptr) {
+        if (neighborhood_ == Neighborhood::MOORE) step<true>(pool);
+        else step<false>(pool);
+    }
+
+    // Number of cells holding each strategy
+    std::vector<long long> counts() const {
+        std::vector<long long> total(k_, 0);
+        for (std::uint16_t type : type_) ++total[type];
+        return total;
+    }
+};
+
+#endif // SPATIALLATTICE_H
@@ -2,14 +2,39 @@
 #define STRATEGIES_H
 
 #include "Strategy.h"
+#include "StrategyFSM.h"
+#include "MemoryOneChain.h"
+#include "Random.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
 #include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
-class AllCooperate : public Strategy {
+class AllCooperate final : public Strategy {
 public:
-	Move decide(const History& history) const override{
+	Move decide(const History& history, StrategyState& state) const override{
         return Move::Cooperate;
 	}
     std::string getName() const override { return "ALLC"; }
+    std::size_t getHistoryWindow() const override { return 0; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, 0, 0);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = 0;
+        return true;
+    }
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        rule = MemoryOneRule::reactive(1.0, 1.0, 1.0);
+        return true;
+    }
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<AllCooperate>(*this);
     }
@@ -22,12 +47,26 @@ public:
 };
 
 // Always Defect (ALLD)
-class AllDefect : public Strategy {
+class AllDefect final : public Strategy {
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
 		return Move::Defect;
     }
     std::string getName() const override { return "ALLD"; }
+    std::size_t getHistoryWindow() const override { return 0; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        fsm = StrategyFSM();
+        fsm.addState(Move::Defect, 0, 0);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = 0;
+        return true;
+    }
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        rule = MemoryOneRule::reactive(0.0, 0.0, 0.0);
+        return true;
+    }
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<AllDefect>(*this);
     }
@@ -40,15 +79,31 @@ public:
 };
 
 // TFT (Tit-For-Tat)
-class TitForTat : public Strategy {
+class TitForTat final : public Strategy {
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
         if (history.empty()) {
 			return Move::Cooperate; // Cooperate in the first round
         }
 		return history.back().second; // Mimic opponent's last move
     }
 	std::string getName() const override { return "TFT"; }
+    std::size_t getHistoryWindow() const override { return 1; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // State = move to play, which is the opponent's last move
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, 0, 1);
+        fsm.addState(Move::Defect, 0, 1);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = history.empty() ? 0 : 1;
+        return true;
+    }
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        rule = MemoryOneRule::reactive(1.0, 1.0, 0.0);
+        return true;
+    }
 
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<TitForTat>(*this);
@@ -62,24 +117,34 @@ public:
 };
 
 // GRIM (Grim Trigger)
-class GrimTrigger : public Strategy {
+class GrimTrigger final : public Strategy {
 private:  
-    mutable bool cooperateForever = true; // Flag: whether to continue cooperating
+    // Per-match state: vars[TRIGGERED] != 0 once the opponent has defected
+    static constexpr int TRIGGERED = 0;
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
         // Start by cooperating
         if (history.empty()) {
             return Move::Cooperate;
 		}
-        if (cooperateForever && history.back().second == Move::Defect)
+        if (!state.vars[TRIGGERED] && history.back().second == Move::Defect)
         {
-			cooperateForever = false; // Once opponent defects, defect forever
+			state.vars[TRIGGERED] = 1; // Once opponent defects, defect forever
         }
-		return cooperateForever ? Move::Cooperate : Move::Defect;
+		return state.vars[TRIGGERED] ? Move::Defect : Move::Cooperate;
     }
 	std::string getName() const override { return "GRIM"; }
-    void reset() const override {
-        cooperateForever = true;
+    std::size_t getHistoryWindow() const override { return 1; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // 0: cooperating, 1: triggered (absorbing)
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, 0, 1);
+        fsm.addState(Move::Defect, 1, 1);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = (history.empty() ? 0 : 1) | (state.vars[TRIGGERED] ? 0 : 2);
+        return true;
     }
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<GrimTrigger>(*this);
@@ -93,9 +158,9 @@ public:
 };
 
 // PAVLOV (Win-Stay-Lose-Shift)
-class PAVLOV: public Strategy {
+class PAVLOV final : public Strategy {
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
         // Start by cooperating
         if (history.empty()) {
             return Move::Cooperate;
@@ -110,6 +175,24 @@ public:
         }
     }
     std::string getName() const override { return "PAVLOV"; }
+    std::size_t getHistoryWindow() const override { return 1; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // State = move to play: keep my move after a matching round, switch otherwise
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, /*CC*/ 0, /*DC*/ 0, /*CD*/ 1, /*DD*/ 1);
+        fsm.addState(Move::Defect, /*CC*/ 0, /*DC*/ 0, /*CD*/ 1, /*DD*/ 1);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = history.empty() ? 0 : 1;
+        return true;
+    }
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        // Keep my move after CC/DD, switch after DC/CD (see decide above)
+        rule.first = 1.0;
+        rule.cooperate = { /*CC*/ 1.0, /*DC*/ 1.0, /*CD*/ 0.0, /*DD*/ 0.0 };
+        return true;
+    }
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<PAVLOV>(*this);
     }
@@ -123,14 +206,17 @@ public:
 
 // CTFT (Contrite Tit-For-Tat) - Contrite Tit-For-Tat
 // Feature: Can identify and repair defection loops caused by its own noise errors
-class ContriteTitForTat : public Strategy {
+class ContriteTitForTat final : public Strategy {
 private:
-    mutable bool contrite = false; // Whether in contrite state
+    // Per-match state: vars[CONTRITE] != 0 while in contrite state
+    static constexpr int CONTRITE = 0;
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
+        int& contrite = state.vars[CONTRITE];
+
         // Cooperate in the first round
         if (history.empty()) {
-            contrite = false;
+            contrite = 0;
             return Move::Cooperate;
         }
 
@@ -142,18 +228,18 @@ public:
         if (contrite) {
             // If opponent defected last round (possibly in response to my defection), I continue cooperating to show contrition
             if (oppLastMove == Move::Defect) {
-                contrite = false; // End contrite state
+                contrite = 0; // End contrite state
                 return Move::Cooperate;
             }
             // If opponent cooperated, it means we've restored cooperation
-            contrite = false;
+            contrite = 0;
             return Move::Cooperate;
         }
 
         // Check if we need to enter contrite state
         // If I defected last time but opponent cooperated, it may be due to my noise error
         if (myLastMove == Move::Defect && oppLastMove == Move::Cooperate) {
-            contrite = true;
+            contrite = 1;
             return Move::Cooperate;
         }
 
@@ -162,10 +248,21 @@ public:
     }
 
     std::string getName() const override { return "CTFT"; }
-
-    void reset() const override {
-        contrite = false;
+    std::size_t getHistoryWindow() const override { return 1; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // 0: cooperate, 1: defect (mirroring), 2: cooperate while contrite
+        // An unprovoked defection of mine (DC) makes me contrite for one round
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, /*CC*/ 0, /*DC*/ 2, /*CD*/ 1, /*DD*/ 1);
+        fsm.addState(Move::Defect, /*CC*/ 0, /*DC*/ 2, /*CD*/ 1, /*DD*/ 1);
+        fsm.addState(Move::Cooperate, 0, 0);
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = (history.empty() ? 0 : 1) | (state.vars[CONTRITE] ? 2 : 0);
+        return true;
     }
+
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<ContriteTitForTat>(*this);
     }
@@ -178,32 +275,39 @@ public:
 };
 
 // Random Strategy
-class RandomStrategy : public Strategy {
+class RandomStrategy final : public Strategy {
 private:
     double      p; // Cooperation probability
-    mutable std::mt19937 gen; // Random number generator
-    mutable std::uniform_real_distribution<double> dist; // Uniform distribution from 0 to 1
 
 public:
-    RandomStrategy() : p(0.2), gen(std::random_device{}()), dist(0.0, 1.0) {
+    RandomStrategy() : p(0.2) {
     };
-    // Constructor: prob is cooperation probability, seed is optional for reproducibility
-    RandomStrategy(double prob, unsigned int seed = std::random_device{}())
-        : p(prob), gen(seed), dist(0.0, 1.0) {
+    // Constructor: prob is cooperation probability; random numbers come from the match state
+    explicit RandomStrategy(double prob)
+        : p(prob) {
     }
 
-    Move decide(const History& history) const override {
-        double r = dist(gen); // Generate random number from 0 to 1
+    Move decide(const History& history, StrategyState& state) const override {
+        double r = state.uniform(); // Generate random number from 0 to 1
         return (r < p) ? Move::Cooperate : Move::Defect;
     }
 
     std::string getName() const override {
         return "RND(prob:" + std::to_string(p) + ")";
     }
+    std::string cacheId() const override {
+        std::ostringstream oss;
+        oss << getName() << '#' << std::hexfloat << p;
+        return oss.str();
+    }
+    std::size_t getHistoryWindow() const override { return 0; }
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        rule = MemoryOneRule::reactive(p, p, p);
+        return true;
+    }
 
     std::unique_ptr<Strategy> clone() const override {
-        // Create new random seed to ensure clone has different random number sequence
-        return std::make_unique<RandomStrategy>(p, std::random_device{}());
+        return std::make_unique<RandomStrategy>(*this);
     }
 
     // SCB: Complexity score
@@ -219,11 +323,12 @@ public:
 //   - First four rounds: C, D, C, C (cooperate, defect, cooperate, cooperate)
 //   - If opponent still cooperates in round 2 (after our defection), consider it exploitable, always defect
 //   - Otherwise, adopt TFT strategy
-class PROBER : public Strategy {
+class PROBER final : public Strategy {
 private:
-    mutable bool exploiting = false; // Whether in exploitation mode
+    // Per-match state: vars[EXPLOITING] != 0 in exploitation mode
+    static constexpr int EXPLOITING = 0;
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
         size_t round = history.size();
 
         // First four rounds probe sequence: C, D, C, C
@@ -237,22 +342,42 @@ public:
             return Move::Cooperate; // Round 3: cooperate
         }
         // Starting from round 4, decide strategy
-        if (round == 3 && !exploiting) {
+        if (round == 3 && !state.vars[EXPLOITING]) {
             if (history[1].second == Move::Cooperate) {
-                exploiting = true;
+                state.vars[EXPLOITING] = 1;
             }
             return Move::Cooperate; // Round 4: cooperate
         }
         // If in exploitation mode, always defect
-        if (exploiting) {
+        if (state.vars[EXPLOITING]) {
             return Move::Defect;
         }
         // Otherwise use TFT strategy
         return history.back().second;
     }
     std::string getName() const override { return "PROBER"; }
-    void reset() const {
-        exploiting = false;
+    // Round 4 looks back at round 2
+    std::size_t getHistoryWindow() const override { return 2; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // Probe C, D, C, C remembering the opponent's answer to the probe,
+        // then either exploit (absorbing D) or play TFT
+        enum : std::uint8_t { R1, R2, R3_EXPLOIT, R3_TFT, R4_EXPLOIT, R4_TFT, EXPLOIT, TFT_C, TFT_D };
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, R2, R2);                 // R1
+        fsm.addState(Move::Defect, R3_EXPLOIT, R3_TFT);        // R2: probe
+        fsm.addState(Move::Cooperate, R4_EXPLOIT, R4_EXPLOIT); // R3_EXPLOIT
+        fsm.addState(Move::Cooperate, R4_TFT, R4_TFT);         // R3_TFT
+        fsm.addState(Move::Cooperate, EXPLOIT, EXPLOIT);       // R4_EXPLOIT
+        fsm.addState(Move::Cooperate, TFT_C, TFT_D);           // R4_TFT
+        fsm.addState(Move::Defect, EXPLOIT, EXPLOIT);          // EXPLOIT
+        fsm.addState(Move::Cooperate, TFT_C, TFT_D);           // TFT_C
+        fsm.addState(Move::Defect, TFT_C, TFT_D);              // TFT_D
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        // The probe sequence depends on the round number up to round 4
+        key = std::min<std::uint64_t>(history.size(), 4) | (state.vars[EXPLOITING] ? 8 : 0);
+        return true;
     }
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<PROBER>(*this);
@@ -265,9 +390,9 @@ public:
     }
 };
 
-class MemoryTwo : public Strategy {
+class MemoryTwo final : public Strategy {
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& state) const override {
         size_t round = history.size();
 
         // First two rounds: trust-building phase, default to cooperation
@@ -297,6 +422,25 @@ public:
     }
 
     std::string getName() const override { return "MEM2"; }
+    std::size_t getHistoryWindow() const override { return 2; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // After the first two rounds the state is the opponent's last two moves;
+        // defect only after two defections in a row
+        enum : std::uint8_t { R1, R2_C, R2_D, LAST_CC, LAST_CD, LAST_DC, LAST_DD };
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, R2_C, R2_D);         // R1
+        fsm.addState(Move::Cooperate, LAST_CC, LAST_CD);   // R2_C
+        fsm.addState(Move::Cooperate, LAST_DC, LAST_DD);   // R2_D
+        fsm.addState(Move::Cooperate, LAST_CC, LAST_CD);   // LAST_CC
+        fsm.addState(Move::Cooperate, LAST_DC, LAST_DD);   // LAST_CD
+        fsm.addState(Move::Cooperate, LAST_CC, LAST_CD);   // LAST_DC
+        fsm.addState(Move::Defect, LAST_DC, LAST_DD);      // LAST_DD
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = std::min<std::uint64_t>(history.size(), 2);
+        return true;
+    }
 
     std::unique_ptr<Strategy> clone() const override {
         return std::make_unique<MemoryTwo>(*this);
@@ -311,7 +455,7 @@ public:
 };
 
 
-class SoftGrudger : public Strategy {
+class SoftGrudger final : public Strategy {
 private:
     // State machine: defines four working states of the strategy
     enum class State {
@@ -321,20 +465,24 @@ private:
         PERMANENT_DEFECT    // Permanent defection mode
     };
 
-    // State variables (mutable allows modification inside const functions)
-    mutable State state = State::COOPERATING;
-    mutable int punishCounter = 0;      // Counter for punishment rounds
-    mutable int reconcileCounter = 0;   // Counter for reconciliation rounds
+    // Per-match state variables (StrategyState::vars; all zero = COOPERATING at match start)
+    static constexpr int MODE = 0;              // Current State
+    static constexpr int PUNISH_COUNTER = 1;    // Counter for punishment rounds
+    static constexpr int RECONCILE_COUNTER = 2; // Counter for reconciliation rounds
 
     // Configurable parameters
     static constexpr int PUNISH_ROUNDS = 4;     // Number of punishment rounds
     static constexpr int RECONCILE_ROUNDS = 2;  // Number of reconciliation rounds
 
 public:
-    Move decide(const History& history) const override {
+    Move decide(const History& history, StrategyState& match) const override {
+        int& mode = match.vars[MODE];
+        int& punishCounter = match.vars[PUNISH_COUNTER];
+        int& reconcileCounter = match.vars[RECONCILE_COUNTER];
+
         // First round: initialize state and cooperate
         if (history.empty()) {
-            state = State::COOPERATING;
+            mode = static_cast<int>(State::COOPERATING);
             return Move::Cooperate;
         }
 
@@ -342,12 +490,12 @@ public:
         Move oppLastMove = history.back().second;
 
         // Finite state machine: make decisions based on current state and opponent's move
-        switch (state) {
+        switch (static_cast<State>(mode)) {
             // ==================== State 1: Cooperation mode ====================
         case State::COOPERATING:
             // If the opponent defects, switch to punishment mode
             if (oppLastMove == Move::Defect) {
-                state = State::PUNISHING;
+                mode = static_cast<int>(State::PUNISHING);
                 punishCounter = 1; // Start counting (current round counts as the first punishment)
                 return Move::Defect; // Immediate retaliation
             }
@@ -360,7 +508,7 @@ public:
 
             // After punishment period ends → attempt reconciliation
             if (punishCounter >= PUNISH_ROUNDS) {
-                state = State::RECONCILING;
+                mode = static_cast<int>(State::RECONCILING);
                 reconcileCounter = 0;
                 return Move::Cooperate; // Offer an olive branch
             }
@@ -374,13 +522,13 @@ public:
 
             // If the opponent defects again during reconciliation → no more forgiveness
             if (oppLastMove == Move::Defect) {
-                state = State::PERMANENT_DEFECT;
+                mode = static_cast<int>(State::PERMANENT_DEFECT);
                 return Move::Defect;
             }
 
             // If reconciliation period ends and opponent cooperated consistently → restore trust
             if (reconcileCounter >= RECONCILE_ROUNDS) {
-                state = State::COOPERATING;
+                mode = static_cast<int>(State::COOPERATING);
             }
 
             // Continue testing opponent’s sincerity
@@ -397,12 +545,27 @@ public:
     }
 
     std::string getName() const override { return "SOFTG"; }
-
-    // Reset function: called when a new game starts
-    void reset() const override {
-        state = State::COOPERATING;
-        punishCounter = 0;
-        reconcileCounter = 0;
+    std::size_t getHistoryWindow() const override { return 1; }
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // Counters unrolled into states: 3 more punishment rounds after the
+        // triggering defection, then 2 reconciliation rounds
+        enum : std::uint8_t { COOPERATING, PUNISH_1, PUNISH_2, PUNISH_3, RECONCILE_1, RECONCILE_2, PERMANENT_DEFECT };
+        fsm = StrategyFSM();
+        fsm.addState(Move::Cooperate, COOPERATING, PUNISH_1);          // COOPERATING
+        fsm.addState(Move::Defect, PUNISH_2, PUNISH_2);                // PUNISH_1
+        fsm.addState(Move::Defect, PUNISH_3, PUNISH_3);                // PUNISH_2
+        fsm.addState(Move::Defect, RECONCILE_1, RECONCILE_1);          // PUNISH_3
+        fsm.addState(Move::Cooperate, RECONCILE_2, PERMANENT_DEFECT);  // RECONCILE_1
+        fsm.addState(Move::Cooperate, COOPERATING, PERMANENT_DEFECT);  // RECONCILE_2
+        fsm.addState(Move::Defect, PERMANENT_DEFECT, PERMANENT_DEFECT); // PERMANENT_DEFECT
+        return true;
+    }
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        key = (history.empty() ? 0 : 1)
+              | (static_cast<std::uint64_t>(state.vars[MODE] & 0xFF) << 1)
+              | (static_cast<std::uint64_t>(state.vars[PUNISH_COUNTER] & 0xFF) << 9)
+              | (static_cast<std::uint64_t>(state.vars[RECONCILE_COUNTER] & 0xFF) << 17);
+        return true;
     }
 
     std::unique_ptr<Strategy> clone() const override {
@@ -417,5 +580,249 @@ public:
     }
 };
 
+// Lookup-table strategies: the move after each history of the last n rounds is read from
+// a table. Two families share this class, written on the command line as
+//   M1:pCC,pCD,pDC,pDD[,p0]  memory-one: probability of cooperating after each outcome of
+//                            the last round (my move first) and in round 1 (default 1)
+//   LT<n>:<hex>[:<opening>]  memory-n, n = 1..8, deterministic: 4^n / 4 hex digits, one
+//                            bit per history, a set bit meaning defect. The first digit's
+//                            high bit is history 0, its low bit history 3, the next digit's
+//                            high bit history 4 and so on. <opening> lists the first n
+//                            moves as C/D (default all C)
+// History k holds the outcome codes of the last n rounds, the latest in the lowest two
+// bits; an outcome code is 1 if I defected plus 2 if the opponent did. So TFT, which
+// defects after histories 2 and 3, is LT1:3 (binary 0011), and win-stay lose-shift
+// (Pavlov), which defects after 1 and 2, is LT1:6 (0110). The key rolls forward by one
+// outcome per decide() in StrategyState::vars, so a decision is one table load for any n.
+class LookupTableStrategy final : public Strategy {
+public:
+    static constexpr int MAX_DEPTH = 8;
+
+private:
+    // Per-match state: vars[KEY] is the rolling history key
+    static constexpr int KEY = 0;
+    static constexpr std::uint8_t MIXED = 2; // entry cooperates with its probability
+
+    int depth_;
+    std::uint32_t mask_;
+    std::vector<std::uint8_t> move_;  // 4^n history entries, then n opening entries: a Move or MIXED
+    std::vector<double> cooperate_;   // cooperation probability of each entry
+    std::string name_;
+
+    explicit LookupTableStrategy(int depth)
+        : depth_(depth), mask_(static_cast<std::uint32_t>(tableSize() - 1)),
+          move_(tableSize() + depth), cooperate_(tableSize() + depth) {}
+
+    std::size_t tableSize() const { return std::size_t(1) << (2 * depth_); }
+
+    void setEntry(std::size_t entry, double p) {
+        cooperate_[entry] = p;
+        move_[entry] = p == 1.0 ? static_cast<std::uint8_t>(Move::Cooperate)
+                     : p == 0.0 ? static_cast<std::uint8_t>(Move::Defect) : MIXED;
+    }
+
+    bool deterministic() const {
+        return std::find(move_.begin(), move_.end(), MIXED) == move_.end();
+    }
+
+    static std::string formatProbability(double p) {
+        std::ostringstream oss;
+        oss << std::setprecision(6) << p;
+        return oss.str();
+    }
+
+    static double parseProbability(const std::string& text, const std::string& spec) {
+        std::size_t used = 0;
+        double p;
+        try {
+            p = std::stod(text, &used);
+        }
+        catch (const std::exception&) {
+            throw std::runtime_error("Invalid probability '" + text + "' in strategy " + spec);
+        }
+        if (used != text.size() || p < 0.0 || p > 1.0) {
+            throw std::runtime_error("Probability must be a number between 0 and 1, got '" + text + "' in strategy " + spec);
+        }
+        return p;
+    }
+
+public:
+    // Memory-one strategy from its cooperation probabilities after CC, CD, DC and DD
+    // (my move first) and in round 1
+    static std::unique_ptr<LookupTableStrategy> memoryOne(double p_cc, double p_cd, double p_dc, double p_dd,
+                                                          double first = 1.0) {
+        std::unique_ptr<LookupTableStrategy> s(new LookupTableStrategy(1));
+        // Outcome codes: bit 0 = I defected, bit 1 = opponent defected
+        s->setEntry(0, p_cc);
+        s->setEntry(1, p_dc);
+        s->setEntry(2, p_cd);
+        s->setEntry(3, p_dd);
+        s->setEntry(4, first);
+        s->name_ = "M1:" + formatProbability(p_cc) + "," + formatProbability(p_cd) + ","
+                 + formatProbability(p_dc) + "," + formatProbability(p_dd)
+                 + (first != 1.0 ? "," + formatProbability(first) : "");
+        return s;
+    }
+
+    // Deterministic memory-n strategy: defect[k] after history k, then the first n moves
+    static std::unique_ptr<LookupTableStrategy> memoryN(int depth, const std::vector<bool>& defect,
+                                                        const std::vector<Move>& opening) {
+        if (depth < 1 || depth > MAX_DEPTH) {
+            throw std::runtime_error("Lookup table depth must be between 1 and " + std::to_string(MAX_DEPTH));
+        }
+        std::unique_ptr<LookupTableStrategy> s(new LookupTableStrategy(depth));
+        const std::size_t size = s->tableSize();
+        if (defect.size() != size || opening.size() != static_cast<std::size_t>(depth)) {
+            throw std::runtime_error("Lookup table of depth " + std::to_string(depth) + " needs "
+                                     + std::to_string(size) + " entries and " + std::to_string(depth) + " opening moves");
+        }
+
+        std::string hex;
+        for (std::size_t k = 0; k < size; k += 4) {
+            int digit = (defect[k] << 3) | (defect[k + 1] << 2) | (defect[k + 2] << 1) | defect[k + 3];
+            hex += "0123456789ABCDEF"[digit];
+            for (std::size_t b = 0; b < 4; ++b) s->setEntry(k + b, defect[k + b] ? 0.0 : 1.0);
+        }
+        std::string moves;
+        for (int r = 0; r < depth; ++r) {
+            s->setEntry(size + r, opening[r] == Move::Cooperate ? 1.0 : 0.0);
+            moves += opening[r] == Move::Cooperate ? 'C' : 'D';
+        }
+        s->name_ = "LT" + std::to_string(depth) + ":" + hex
+                 + (moves.find('D') != std::string::npos ? ":" + moves : "");
+        return s;
+    }
+
+    // Whether a strategy name is a lookup-table spec
+    static bool isSpec(const std::string& name) {
+        return name.rfind("M1:", 0) == 0 || (name.rfind("LT", 0) == 0 && name.find(':') != std::string::npos);
+    }
+
+    // Build a strategy from its spec (see above); throws std::runtime_error if it is malformed
+    static std::unique_ptr<LookupTableStrategy> parse(const std::string& spec) {
+        if (spec.rfind("M1:", 0) == 0) {
+            std::vector<double> p;
+            std::stringstream fields(spec.substr(3));
+            std::string field;
+            while (std::getline(fields, field, ',')) p.push_back(parseProbability(field, spec));
+            if (p.size() != 4 && p.size() != 5) {
+                throw std::runtime_error("M1 strategy needs 4 or 5 probabilities (pCC,pCD,pDC,pDD[,p0]): " + spec);
+            }
+            return memoryOne(p[0], p[1], p[2], p[3], p.size() == 5 ? p[4] : 1.0);
+        }
+
+        // LT<n>:<hex>[:<opening>]
+        std::size_t colon = spec.find(':');
+        const std::string depth_text = spec.substr(2, colon - 2);
+        // Plain decimal only, so the canonical name is exactly what was typed
+        int depth = 0;
+        try {
+            if (depth_text.empty() || depth_text[0] == '0'
+                || depth_text.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::invalid_argument(depth_text);
+            }
+            depth = std::stoi(depth_text);
+        }
+        catch (const std::exception&) {
+            throw std::runtime_error("Invalid lookup table depth in strategy " + spec);
+        }
+        if (depth < 1 || depth > MAX_DEPTH) {
+            throw std::runtime_error("Lookup table depth must be between 1 and " + std::to_string(MAX_DEPTH) + ": " + spec);
+        }
+        std::size_t second = spec.find(':', colon + 1);
+        std::string hex = spec.substr(colon + 1, second == std::string::npos ? std::string::npos : second - colon - 1);
+        const std::size_t size = std::size_t(1) << (2 * depth);
+        if (hex.size() != size / 4) {
+            throw std::runtime_error("Lookup table of depth " + std::to_string(depth) + " needs "
+                                     + std::to_string(size / 4) + " hex digits: " + spec);
+        }
+        std::vector<bool> defect;
+        defect.reserve(size);
+        for (char c : hex) {
+            int digit = std::isdigit(static_cast<unsigned char>(c)) ? c - '0'
+                      : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                      : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0) throw std::runtime_error("Invalid hex digit '" + std::string(1, c) + "' in strategy " + spec);
+            for (int b = 3; b >= 0; --b) defect.push_back((digit >> b) & 1);
+        }
+
+        std::vector<Move> opening(depth, Move::Cooperate);
+        if (second != std::string::npos) {
+            std::string moves = spec.substr(second + 1);
+            if (moves.size() != static_cast<std::size_t>(depth) || moves.find_first_not_of("CD") != std::string::npos) {
+                throw std::runtime_error("Opening must be " + std::to_string(depth) + " moves of C/D: " + spec);
+            }
+            for (int r = 0; r < depth; ++r) opening[r] = moves[r] == 'C' ? Move::Cooperate : Move::Defect;
+        }
+        return memoryN(depth, defect, opening);
+    }
+
+    Move decide(const History& history, StrategyState& state) const override {
+        const std::size_t round = history.size();
+        std::uint32_t key = static_cast<std::uint32_t>(state.vars[KEY]);
+        if (round > 0) {
+            key = ((key << 2) | history.lastOutcome()) & mask_;
+            state.vars[KEY] = static_cast<std::int32_t>(key);
+        }
+        const std::size_t entry = round < static_cast<std::size_t>(depth_) ? tableSize() + round : key;
+        const std::uint8_t move = move_[entry];
+        if (move != MIXED) {
+            return static_cast<Move>(move);
+        }
+        return state.uniform() < cooperate_[entry] ? Move::Cooperate : Move::Defect;
+    }
+
+    std::string getName() const override { return name_; }
+    int getDepth() const { return depth_; }
+
+    // Names of mixed tables round their probabilities to 6 digits
+    std::string cacheId() const override {
+        if (deterministic()) return name_;
+        std::ostringstream oss;
+        oss << name_ << std::hexfloat;
+        for (double p : cooperate_) oss << '#' << p;
+        return oss.str();
+    }
+
+    // Only the last outcome is read; older rounds live in the rolling key
+    std::size_t getHistoryWindow() const override { return 1; }
+
+    bool exportFSM(StrategyFSM& fsm) const override {
+        // Depth 1 only: state 0 plays the opening move, state 1 + code answers outcome code
+        if (depth_ != 1 || !deterministic()) return false;
+        fsm = StrategyFSM();
+        fsm.addState(static_cast<Move>(move_[4]), 1, 2, 3, 4);
+        for (std::size_t code = 0; code < 4; ++code) {
+            fsm.addState(static_cast<Move>(move_[code]), 1, 2, 3, 4);
+        }
+        return true;
+    }
+
+    bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const override {
+        if (!deterministic()) return false;
+        // The opening depends on the round number up to round n
+        std::uint64_t round = std::min<std::uint64_t>(history.size(), static_cast<std::uint64_t>(depth_));
+        key = static_cast<std::uint32_t>(state.vars[KEY]) | (round << (2 * depth_));
+        return true;
+    }
+
+    bool getMemoryOne(MemoryOneRule& rule) const override {
+        if (depth_ != 1) return false;
+        rule.first = cooperate_[4];
+        for (std::size_t code = 0; code < 4; ++code) rule.cooperate[code] = cooperate_[code];
+        return true;
+    }
+
+    std::unique_ptr<Strategy> clone() const override {
+        return std::make_unique<LookupTableStrategy>(*this);
+    }
+
+    // SCB: Complexity score grows with the memory depth
+    double getComplexity() const override { return 1.0 + depth_; }
+    std::string getComplexityReason() const override {
+        return std::to_string(depth_) + "-round memory lookup table" + (deterministic() ? "" : " with random moves");
+    }
+};
+
 #endif // STRATEGIES_H
 
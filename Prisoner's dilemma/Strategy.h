@@ -1,58 +1,104 @@
 ﻿#ifndef STRATEGY_H
 #define STRATEGY_H
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <random>
-enum class Move { Cooperate, Defect };
+#include <memory>
+#include "MatchHistory.h"
+#include "RandomEngine.h"
 
-using History = std::vector<std::pair<Move, Move>>;
+struct StrategyFSM;
+struct MemoryOneRule;
 
+/**
+ * @brief Everything about one player that changes during a match
+ *
+ * Strategies are immutable rules; the match engine owns one StrategyState per
+ * player and passes it to every decide() call. vars holds the rule's own flags and
+ * counters and is all zero at the start of a match; rng drives noise flips and
+ * random moves. States are plain values, so any number of matches can run on
+ * one strategy object at the same time.
+ */
+struct StrategyState {
+    std::array<std::int32_t, 4> vars{};
+    RandomEngine rng;
+    GeometricFlipSampler flips; // moves until the next noise flip
+    double flip_noise = 0.0;    // noise level `flips` was drawn for
 
-class Strategy {
+    explicit StrategyState(std::uint64_t seed = std::mt19937::default_seed, RngKind kind = RngKind::MT19937)
+        : rng(seed, kind) {}
 
-inline static double noise=0.0; // Error rate
-// SCB (Strategic Complexity Budget) related static variables
-inline static bool enable_scb = false;           // Whether to enable Strategic Complexity Budget
-inline static double scb_cost_factor = 0.1;      // Cost coefficient per complexity unit per round
+    // Start a new match; the random stream and the flip countdown carry on
+    void reset() { vars.fill(0); }
 
-private:
-	mutable std::mt19937 gen; // Random number generator
-    mutable std::uniform_real_distribution<double> dist{ 0.0, 1.0 };; // Uniform distribution from 0 to 1
+    // Uniform double in [0, 1)
+    double uniform() { return std::uniform_real_distribution<double>(0.0, 1.0)(rng); }
 
-public:
+    // Whether noise flips the next move. Each move flips independently with probability
+    // `noise`, but the RNG is only drawn once per flip: a geometric countdown to the next one.
+    bool flipNext(double noise) {
+        if (noise != flip_noise) {
+            flips = GeometricFlipSampler(noise, rng);
+            flip_noise = noise;
+        }
+        return flips.next(rng);
+    }
+};
 
-    // Set noise parameter
-    static  void setNoise(double epsilon) { noise = epsilon; }
-	void setSeed(unsigned int seed) { gen.seed(seed); }
-    double getNoise() const { return noise; }
-    
-    // SCB: Set complexity budget parameters
-    static void enableSCB(bool enable) { enable_scb = enable; }
-    static void setSCBCostFactor(double factor) { scb_cost_factor = factor; }
-    static bool isSCBEnabled() { return enable_scb; }
-    static double getSCBCostFactor() { return scb_cost_factor; }
-    
+
+class Strategy {
+
+public:
+    // Noise level and SCB settings are not part of a strategy; they come from the
+    // SimulationContext of each run (see SimulationContext.h)
     virtual ~Strategy() = default;
-    virtual Move decide(const History& history) const = 0;
+    // Choose the next move. All per-match state lives in `state`, never in the strategy.
+    virtual Move decide(const History& history, StrategyState& state) const = 0;
     virtual std::string getName() const = 0;
     virtual std::unique_ptr<Strategy> clone() const = 0;
 
-    Move applyNoise(Move move) const {
+    // Identity of the strategy's behavior in result-cache keys: two strategies that can
+    // play differently must differ here. Strategies whose name rounds a parameter add it
+    // at full precision.
+    virtual std::string cacheId() const { return getName(); }
+
+    // Flip the move with probability `noise`
+    Move applyNoise(Move move, double noise, StrategyState& state) const {
         if (noise == 0)
         {
             return move;
         }
-        if (dist(gen) < noise) {
+        if (state.flipNext(noise)) {
             return move == Move::Cooperate ? Move::Defect : Move::Cooperate;
         }
         return move;
     };
 
-    virtual void reset() const {};
+    // Number of most recent rounds decide() reads; lets the simulator keep a
+    // fixed-size ring buffer instead of the whole match. Unknown strategies keep everything.
+    virtual std::size_t getHistoryWindow() const { return MatchHistory::FULL_HISTORY; }
+
+    // Export the strategy as a finite state machine (see StrategyFSM.h).
+    // Returns false for strategies that are not deterministic state machines.
+    virtual bool exportFSM(StrategyFSM& fsm) const { return false; }
+
+    // Snapshot the per-match state between rounds, for cycle detection in noise-free matches.
+    // Together with the last getHistoryWindow() rounds the snapshot must determine every
+    // future decision (include the round count if decide() looks at it).
+    // Returns false for strategies that cannot be snapshotted, e.g. random ones.
+    virtual bool snapshotState(const History& history, const StrategyState& state, std::uint64_t& key) const {
+        return false;
+    }
+
+    // Export the strategy as a memory-one rule (see MemoryOneChain.h), used by --exact.
+    // Returns false for strategies that look further back than the last round.
+    virtual bool getMemoryOne(MemoryOneRule& rule) const { return false; }
 
-    Move decideWithNoise(const History& history) const {
-        return applyNoise(decide(history));
+    Move decideWithNoise(const History& history, double noise, StrategyState& state) const {
+        return applyNoise(decide(history, state), noise, state);
     }
 
     // SCB: Return strategy's complexity score (pure virtual function, must be implemented by subclasses)
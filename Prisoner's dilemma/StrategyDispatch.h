@@ -0,0 +1,53 @@
+﻿#ifndef STRATEGYDISPATCH_H
+#define STRATEGYDISPATCH_H
+
+#include <typeinfo>
+#include <utility>
+#include "Strategy.h"
+#include "Strategies.h"
+
+/**
+ * @brief Compile-time list of strategy types
+ *
+ * Used to turn a Strategy reference into its concrete (final) type once per match,
+ * so the match loop can be instantiated per strategy pair and the compiler can
+ * inline each decide() call instead of going through the vtable every round.
+ */
+template<typename... Ts>
+struct StrategyList {};
+
+// Closed set of built-in strategies from Strategies.h
+using BuiltinStrategies = StrategyList<
+    AllCooperate, AllDefect, TitForTat, GrimTrigger, PAVLOV,
+    ContriteTitForTat, RandomStrategy, PROBER, MemoryTwo, SoftGrudger, LookupTableStrategy>;
+
+// End of the list: the strategy is not one of the known types
+template<typename Visitor>
+bool dispatchStrategy(const Strategy&, Visitor&&, StrategyList<>) {
+    return false;
+}
+
+// Call visitor with the concrete type of s if it is exactly one of the listed types.
+// Subclasses of a listed type do not match, so overridden behaviour is never bypassed.
+template<typename Visitor, typename T, typename... Rest>
+bool dispatchStrategy(const Strategy& s, Visitor&& visitor, StrategyList<T, Rest...>) {
+    if (typeid(s) == typeid(T)) {
+        visitor(static_cast<const T&>(s));
+        return true;
+    }
+    return dispatchStrategy(s, std::forward<Visitor>(visitor), StrategyList<Rest...>{});
+}
+
+// Call visitor(a, b) with both concrete types; returns false if either is unknown
+template<typename Visitor, typename List = BuiltinStrategies>
+bool dispatchStrategyPair(const Strategy& a, const Strategy& b, Visitor&& visitor, List list = List{}) {
+    bool matched = false;
+    dispatchStrategy(a, [&](const auto& concrete_a) {
+        matched = dispatchStrategy(b, [&](const auto& concrete_b) {
+            visitor(concrete_a, concrete_b);
+        }, list);
+    }, list);
+    return matched;
+}
+
+#endif // STRATEGYDISPATCH_H
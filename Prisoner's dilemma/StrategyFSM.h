@@ -0,0 +1,50 @@
+﻿#ifndef STRATEGYFSM_H
+#define STRATEGYFSM_H
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include "MatchHistory.h"
+
+/**
+ * @brief Finite-state-machine form of a deterministic strategy
+ *
+ * Moore machine: each state has a fixed move, and after every round the machine
+ * moves to a new state based on the round's outcome code (bit 0 = I defected,
+ * bit 1 = opponent defected). Using my actual move rather than the intended one
+ * keeps the table correct when noise flips a move.
+ *
+ * At most 16 states, so two machines fit in one joint-state byte.
+ */
+struct StrategyFSM {
+    static constexpr int MAX_STATES = 16;
+
+    // Outcome codes, from the owning player's perspective
+    static constexpr std::uint8_t CC = 0; // both cooperated
+    static constexpr std::uint8_t DC = 1; // I defected, opponent cooperated
+    static constexpr std::uint8_t CD = 2; // I cooperated, opponent defected
+    static constexpr std::uint8_t DD = 3; // both defected
+
+    std::uint8_t num_states = 0;
+    std::uint8_t initial_state = 0;
+    std::array<Move, MAX_STATES> output{};
+    std::array<std::array<std::uint8_t, 4>, MAX_STATES> next{};
+
+    // Add a state that reacts to the full outcome; returns its index
+    std::uint8_t addState(Move move, std::uint8_t on_cc, std::uint8_t on_dc,
+                          std::uint8_t on_cd, std::uint8_t on_dd) {
+        if (num_states >= MAX_STATES) {
+            throw std::length_error("StrategyFSM supports at most 16 states");
+        }
+        output[num_states] = move;
+        next[num_states] = { on_cc, on_dc, on_cd, on_dd };
+        return num_states++;
+    }
+
+    // Add a state that only reacts to the opponent's move; returns its index
+    std::uint8_t addState(Move move, std::uint8_t if_opp_cooperates, std::uint8_t if_opp_defects) {
+        return addState(move, if_opp_cooperates, if_opp_cooperates, if_opp_defects, if_opp_defects);
+    }
+};
+
+#endif // STRATEGYFSM_H
@@ -0,0 +1,171 @@
+﻿#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Small work-stealing thread pool
+ *
+ * Each worker owns a task deque: it pops its own tasks from the back and, when
+ * empty, steals from the front of the other deques. Threads that submit work
+ * (queue 0) run tasks too while they wait, so parallelFor may be called from
+ * inside a task without deadlocking.
+ *
+ * A pool of N threads starts N - 1 workers; with N = 1 everything runs inline.
+ */
+class ThreadPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; // queue 0 belongs to submitting threads
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> pending_{ 0 };      // queued tasks not yet started
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    // Queue owned by the current thread (0 for threads outside the pool)
+    static std::size_t& ownQueue() {
+        static thread_local std::size_t index = 0;
+        return index;
+    }
+
+    // Pop from our own queue, else steal from the others. Returns false if all are empty.
+    bool runOne(std::size_t self) {
+        std::function<void()> task;
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (std::size_t k = 1; !task && k < queues_.size(); ++k) {
+            Queue& victim = *queues_[(self + k) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+        --pending_;
+        task();
+        return true;
+    }
+
+    void workerLoop(std::size_t index) {
+        ownQueue() = index;
+        while (true) {
+            if (runOne(index)) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+            if (stop_ && pending_ == 0) return;
+        }
+    }
+
+public:
+    // threads = 0 uses every hardware thread
+    explicit ThreadPool(unsigned threads = 1) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 1; i < threads; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Run task(i) for every i in [0, count) and wait for all of them.
+    // The first exception thrown by a task is rethrown here.
+    template<typename Task>
+    void parallelFor(std::size_t count, Task&& task) {
+        if (count == 0) return;
+        if (workers_.empty()) {
+            for (std::size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+
+        struct Group {
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        };
+        auto group = std::make_shared<Group>();
+        group->remaining = count;
+
+        // Deal the tasks round-robin over the queues; idle threads steal the rest
+        for (std::size_t i = 0; i < count; ++i) {
+            Queue& queue = *queues_[i % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.emplace_back([group, &task, i] {
+                try {
+                    task(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(group->mutex);
+                    if (!group->error) group->error = std::current_exception();
+                }
+                if (--group->remaining == 0) {
+                    std::lock_guard<std::mutex> lock(group->mutex);
+                    group->done.notify_all();
+                }
+            });
+            ++pending_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wake_.notify_all();
+
+        // Help out until our group is finished
+        const std::size_t self = ownQueue();
+        while (group->remaining > 0) {
+            if (!runOne(self)) {
+                std::unique_lock<std::mutex> lock(group->mutex);
+                group->done.wait_for(lock, std::chrono::milliseconds(1),
+                                     [&group] { return group->remaining == 0; });
+            }
+        }
+
+        if (group->error) {
+            std::rethrow_exception(group->error);
+        }
+    }
+};
+
+#endif // THREADPOOL_H
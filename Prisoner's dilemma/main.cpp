@@ -5,10 +5,14 @@
 #include <stdexcept>
 #include "SimulatorRunner.h"
 #include "Config.h"
+#include "SelfTest.h"
 int main(int argc, char** argv) {
     try {
         // 1. Parse command-line arguments to generate a configuration object.
         Config config = SimulatorRunner::parseArguments(argc, argv);
+        if (config.self_test) {
+            return SelfTest::runAll() == 0 ? 0 : 1;
+        }
 
         // 2. Create and run the application using this configuration.
         SimulatorRunner runner(config);